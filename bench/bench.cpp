@@ -0,0 +1,719 @@
+#include <vecmath/animation.hpp>
+#include <vecmath/backend.hpp>
+#include <vecmath/batch.hpp>
+#include <vecmath/bvh.hpp>
+#include <vecmath/dualquat.hpp>
+#include <vecmath/expr.hpp>
+#include <vecmath/fastmath.hpp>
+#include <vecmath/frustum.hpp>
+#include <vecmath/packed.hpp>
+#include <vecmath/pi.hpp>
+#include <vecmath/pointstream.hpp>
+#include <vecmath/skinning.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//micro-benchmarks for the public vecmath functions
+//
+//every function is timed twice:
+//  latency    - each call's input depends on the previous call's result, so calls run back to back
+//  throughput - the function runs over 'batch' independent inputs, so calls overlap in the pipeline
+//
+//usage: vecmath_bench [--filter <substring>] [--min-time <ms>] [--json <file>] [--backend scalar|sse2|avx2]
+
+using namespace vcm;
+
+namespace
+{
+	//independent inputs per throughput repetition (the mat4 inputs and outputs fit in l1)
+	const std::size_t batch = 128;
+
+	//elements per repetition of the array benchmarks
+	const std::size_t array_size = 4096;
+
+	//timed runs per benchmark; the fastest one is reported
+	const int repeats = 5;
+
+	double min_time_ns = 20e6;
+	const char* filter = "";
+
+	struct result
+	{
+		std::string name;
+		double latency_ns;      //negative when there is no latency form
+		double latency_cycles;
+		double throughput_ns;
+		double throughput_cycles;
+	};
+
+	std::vector<result> results;
+
+	//makes the compiler assume 'value' is read, so the computation producing it is kept
+	template <typename T>
+	void escape(const T& value)
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "r"(&value) : "memory");
+#else
+		static const void* volatile sink;
+		sink = &value;
+#endif
+	}
+
+	bool has_cycles()
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	//time stamp counter: on current x86 cpus it ticks at the nominal frequency,
+	//not the boosted core clock, so cycle counts are nominal cycles
+	std::uint64_t cycles()
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return 0;
+#endif
+	}
+
+	struct timing
+	{
+		double ns;
+		double cycles;
+	};
+
+	//calls run(reps) with enough repetitions to last 'min_time_ns' and returns the time per op
+	//for the fastest of 'repeats' runs, where each repetition performs 'ops' ops
+	template <typename F>
+	timing measure(F run, double ops)
+	{
+		typedef std::chrono::steady_clock clock;
+
+		std::size_t reps = 1;
+
+		for (;;)
+		{
+			clock::time_point start = clock::now();
+			run(reps);
+			double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+			if (ns >= min_time_ns / repeats || reps >= ((std::size_t)1 << 40))
+				break;
+
+			reps *= ns * 8 < min_time_ns / repeats ? 8 : 2;
+		}
+
+		timing best = { 1e300, 1e300 };
+
+		for (int i = 0; i < repeats; ++i)
+		{
+			clock::time_point start = clock::now();
+			std::uint64_t c0 = cycles();
+			run(reps);
+			std::uint64_t c1 = cycles();
+			double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+			best.ns = std::min(best.ns, ns / (reps * ops));
+			best.cycles = std::min(best.cycles, (double)(c1 - c0) / (reps * ops));
+		}
+
+		return best;
+	}
+
+	bool selected(const char* name)
+	{
+		return std::strstr(name, filter) != nullptr;
+	}
+
+	//the first component of a result, which the latency chain feeds into the next input
+	float first(float f) { return f; }
+	float first(const vec2& v) { return v.x; }
+	float first(const vec3& v) { return v.x; }
+	float first(const vec4& v) { return v.x; }
+	float first(const quat& q) { return q.x; }
+	float first(const mat2& m) { return m.m[0].x; }
+	float first(const mat3& m) { return m.m[0].x; }
+	float first(const mat4& m) { return m.m[0].x; }
+	float first(const affine3& a) { return a.m[0].x; }
+	float first(const dualquat& dq) { return dq.real.x; }
+	float first(const aabb& b) { return b.min.x; }
+
+	//adds 'd' to the first component of an input
+	void nudge(float& f, float d) { f += d; }
+	void nudge(vec2& v, float d) { v.x += d; }
+	void nudge(vec3& v, float d) { v.x += d; }
+	void nudge(vec4& v, float d) { v.x += d; }
+	void nudge(quat& q, float d) { q.x += d; }
+	void nudge(mat2& m, float d) { m.m[0].x += d; }
+	void nudge(mat3& m, float d) { m.m[0].x += d; }
+	void nudge(mat4& m, float d) { m.m[0].x += d; }
+	void nudge(affine3& a, float d) { a.m[0].x += d; }
+	void nudge(dualquat& dq, float d) { dq.real.x += d; }
+	void nudge(aabb& b, float d) { b.min.x += d; }
+
+	//times 'f' on the inputs 'in'
+	//the latency chain adds 0 * first(result) to the next input: the value stays the same, so every call
+	//takes the same path, but the call cannot start before the previous one finished; the extra
+	//multiply-add is measured by the "feedback" benchmark
+	template <typename In, typename F>
+	void bench(const char* name, const std::vector<In>& in, F f)
+	{
+		if (!selected(name))
+			return;
+
+		typedef decltype(f(in[0])) Out;
+
+		timing latency = measure([&](std::size_t reps)
+		{
+			In cur = in[0];
+			float zero = 0.0f;
+			escape(zero);
+
+			for (std::size_t r = 0; r < reps; ++r)
+			{
+				Out out = f(cur);
+				nudge(cur, first(out) * zero);
+			}
+
+			escape(cur);
+		}, 1);
+
+		std::vector<Out> out(batch);
+
+		timing throughput = measure([&](std::size_t reps)
+		{
+			for (std::size_t r = 0; r < reps; ++r)
+			{
+				for (std::size_t i = 0; i < batch; ++i)
+					out[i] = f(in[i]);
+
+				escape(out[0]);
+			}
+		}, batch);
+
+		result res = { name, latency.ns, latency.cycles, throughput.ns, throughput.cycles };
+		results.push_back(res);
+	}
+
+	//times an array function; run() processes 'n' elements, and there is no latency form
+	template <typename F>
+	void bench_array(const char* name, std::size_t n, F run)
+	{
+		if (!selected(name))
+			return;
+
+		timing throughput = measure([&](std::size_t reps)
+		{
+			for (std::size_t r = 0; r < reps; ++r)
+				run();
+		}, (double)n);
+
+		result res = { name, -1, -1, throughput.ns, throughput.cycles };
+		results.push_back(res);
+	}
+
+	//deterministic pseudo-random floats in [lo, hi)
+	float random(float lo, float hi)
+	{
+		static std::uint32_t state = 12345;
+		state = state * 1664525u + 1013904223u;
+
+		return lo + (hi - lo) * (float)(state >> 8) / 16777216.0f;
+	}
+
+	template <typename T, typename G>
+	std::vector<T> make(G gen)
+	{
+		std::vector<T> v;
+		v.reserve(batch);
+
+		for (std::size_t i = 0; i < batch; ++i)
+			v.push_back(gen());
+
+		return v;
+	}
+
+	vec3 random_vec3() { return vec3(random(-1, 1), random(-1, 1), random(-1, 1)); }
+	vec4 random_vec4() { return vec4(random(-1, 1), random(-1, 1), random(-1, 1), random(-1, 1)); }
+	quat random_quat() { return euler(vec3(random(-PI, PI), random(-PI, PI), random(-PI, PI))); }
+	mat4 random_mat4() { return compose(random_vec3() * 10.0f, random_quat(), vec3(random(0.5f, 2), random(0.5f, 2), random(0.5f, 2))); }
+
+	//the functions shared by every vector type
+	template <typename V>
+	void bench_vector(const std::string& prefix, const std::vector<V>& v, const V& other)
+	{
+		bench((prefix + " + " + prefix).c_str(), v, [&](const V& a) { return a + other; });
+		bench((prefix + " * " + prefix).c_str(), v, [&](const V& a) { return a * other; });
+		bench((prefix + " * float").c_str(), v, [&](const V& a) { return a * 0.5f; });
+		bench((prefix + " / float").c_str(), v, [&](const V& a) { return a / 3.0f; });
+		bench(("length(" + prefix + ")").c_str(), v, [&](const V& a) { return length(a); });
+		bench(("length_squared(" + prefix + ")").c_str(), v, [&](const V& a) { return length_squared(a); });
+		bench(("dot(" + prefix + ")").c_str(), v, [&](const V& a) { return dot(a, other); });
+		bench(("normalize(" + prefix + ")").c_str(), v, [&](const V& a) { return normalize(a); });
+		bench(("lerp(" + prefix + ")").c_str(), v, [&](const V& a) { return lerp(a, other, 0.25f); });
+	}
+
+	template <typename V>
+	void bench_minmax(const std::string& prefix, const std::vector<V>& v, const V& other)
+	{
+		bench(("clamp_length(" + prefix + ")").c_str(), v, [&](const V& a) { return clamp_length(a, 0.5f); });
+		bench(("min(" + prefix + ")").c_str(), v, [&](const V& a) { return min(a, other); });
+		bench(("max(" + prefix + ")").c_str(), v, [&](const V& a) { return max(a, other); });
+	}
+
+	void run_all()
+	{
+		std::vector<float> floats = make<float>([] { return random(-PI, PI); });
+		std::vector<vec2> v2 = make<vec2>([] { return vec2(random(-1, 1), random(-1, 1)); });
+		std::vector<vec3> v3 = make<vec3>(random_vec3);
+		std::vector<vec4> v4 = make<vec4>(random_vec4);
+		std::vector<quat> q = make<quat>(random_quat);
+		std::vector<mat2> m2 = make<mat2>([] { return from_angle(random(-PI, PI)) * random(0.5f, 2); });
+		std::vector<mat3> m3 = make<mat3>([] { return mat3(random_mat4()); });
+		std::vector<mat4> m4 = make<mat4>(random_mat4);
+		std::vector<affine3> a3 = make<affine3>([] { return affine3(random_mat4()); });
+
+		vec3 other3 = random_vec3();
+		vec4 other4v = random_vec4();
+		quat otherq = random_quat();
+		mat4 other4 = random_mat4();
+		affine3 othera(random_mat4());
+
+		bench("feedback", floats, [](float f) { return f; });
+
+		//vector.hpp
+		bench_vector<vec2>("vec2", v2, vec2(0.3f, -0.7f));
+		bench_minmax<vec2>("vec2", v2, vec2(0.3f, -0.7f));
+		bench_vector<vec3>("vec3", v3, other3);
+		bench_minmax<vec3>("vec3", v3, other3);
+		bench("cross(vec3)", v3, [&](const vec3& a) { return cross(a, other3); });
+		bench_vector<vec4>("vec4", v4, other4v);
+		bench_minmax<vec4>("vec4", v4, other4v);
+
+		bench_vector<quat>("quat", q, otherq);
+		bench("inverse(quat)", q, [](const quat& a) { return inverse(a); });
+		bench("slerp", q, [&](const quat& a) { return slerp(a, otherq, 0.3f); });
+		bench("angle_axis", floats, [&](float f) { return angle_axis(f, vec3::up); });
+		bench("euler", v3, [](const vec3& a) { return euler(a); });
+		bench("quat(mat3)", m3, [](const mat3& m) { return quat(m); });
+		bench("mat3(quat) * vec3", q, [&](const quat& a) { return mat3(a) * other3; });
+		bench("rotate(quat, vec3)", q, [&](const quat& a) { return rotate(a, other3); });
+
+		//matrix.hpp
+		bench("mat2 * mat2", m2, [&](const mat2& m) { return m * m2[1]; });
+		bench("mat2 * vec2", m2, [&](const mat2& m) { return m * v2[1]; });
+		bench("transpose(mat2)", m2, [](const mat2& m) { return transpose(m); });
+		bench("determinant(mat2)", m2, [](const mat2& m) { return determinant(m); });
+		bench("inverse(mat2)", m2, [](const mat2& m) { return inverse(m); });
+		bench("from_angle", floats, [](float f) { return from_angle(f); });
+
+		bench("mat3 * mat3", m3, [&](const mat3& m) { return m * m3[1]; });
+		bench("mat3 * vec3", m3, [&](const mat3& m) { return m * other3; });
+		bench("transpose(mat3)", m3, [](const mat3& m) { return transpose(m); });
+		bench("determinant(mat3)", m3, [](const mat3& m) { return determinant(m); });
+		bench("inverse(mat3)", m3, [](const mat3& m) { return inverse(m); });
+		bench("mat3(quat)", q, [](const quat& a) { return mat3(a); });
+		bench("look_rotation", v3, [](const vec3& a) { return look_rotation(a); });
+
+		bench("mat4 * mat4", m4, [&](const mat4& m) { return m * other4; });
+		bench("mat4 * vec4", m4, [&](const mat4& m) { return m * v4[1]; });
+		bench("transpose(mat4)", m4, [](const mat4& m) { return transpose(m); });
+		bench("determinant(mat4)", m4, [](const mat4& m) { return determinant(m); });
+		bench("inverse(mat4)", m4, [](const mat4& m) { return inverse(m); });
+		bench("inverse_affine(mat4)", m4, [](const mat4& m) { return inverse_affine(m); });
+		bench("transpose(inverse(mat3))", m4, [](const mat4& m) { return transpose(inverse(mat3(m))); });
+		bench("normal_matrix(mat4)", m4, [](const mat4& m) { return normal_matrix(m); });
+		bench("look_at", v3, [&](const vec3& a) { return look_at(a, other3); });
+		bench("compose(tran, rot)", q, [&](const quat& a) { return compose(other3, a); });
+		bench("compose(tran, rot, scale)", q, [&](const quat& a) { return compose(other3, a, vec3(2.0f)); });
+		bench("perspective", floats, [](float f) { return perspective(1.0f + f * 0.1f, 1.5f, 0.1f, 100.0f); });
+		bench("orthographic", floats, [](float f) { return orthographic(-f, f, -1.0f, 1.0f, 0.1f, 100.0f); });
+
+		//affine.hpp
+		bench("affine3 * affine3", a3, [&](const affine3& a) { return a * othera; });
+		bench("inverse(affine3)", a3, [](const affine3& a) { return inverse(a); });
+		bench("transform_point(affine3)", v3, [&](const vec3& p) { return transform_point(othera, p); });
+		bench("compose_affine", q, [&](const quat& a) { return compose_affine(other3, a, vec3(2.0f)); });
+
+		//dualquat.hpp
+		std::vector<dualquat> dq = make<dualquat>([] { return dualquat(random_vec3() * 10.0f, random_quat()); });
+		dualquat otherdq(other3, otherq);
+
+		bench("dualquat * dualquat", dq, [&](const dualquat& a) { return a * otherdq; });
+		bench("normalize(dualquat)", dq, [](const dualquat& a) { return normalize(a); });
+		bench("transform_point(dualquat)", v3, [&](const vec3& p) { return transform_point(otherdq, p); });
+
+		//aabb.hpp
+		std::vector<aabb> boxes = make<aabb>([] { vec3 c = random_vec3(); return aabb(c - vec3(0.5f), c + vec3(0.5f)); });
+		bench("transform(aabb)", boxes, [&](const aabb& b) { return transform(other4, b); });
+		bench("merge(aabb)", boxes, [&](const aabb& b) { return merge(b, other3); });
+
+		//fastmath.hpp, next to the precise functions above
+		bench("rsqrt_fast", floats, [](float f) { return rsqrt_fast(f * f + 1); });
+		bench("normalize_fast(vec3)", v3, [](const vec3& a) { return normalize_fast(a); });
+		bench("normalize_fast(quat)", q, [](const quat& a) { return normalize_fast(a); });
+		bench("sin, cos", floats, [](float f) { return vec2(std::sin(f), std::cos(f)); });
+		bench("sincos_fast", floats, [](float f) { float s, c; sincos_fast(f, s, c); return vec2(s, c); });
+		bench("acos", floats, [](float f) { return std::acos(f * 0.3f); });
+		bench("acos_fast", floats, [](float f) { return acos_fast(f * 0.3f); });
+		bench("atan2", v2, [](const vec2& a) { return std::atan2(a.y, a.x); });
+		bench("atan2_fast", v2, [](const vec2& a) { return atan2_fast(a.y, a.x); });
+		bench("angle_axis<fast_math>", floats, [&](float f) { return angle_axis<fast_math>(f, vec3::up); });
+		bench("euler<fast_math>", v3, [](const vec3& a) { return euler<fast_math>(a); });
+		bench("perspective<fast_math>", floats, [](float f) { return perspective<fast_math>(1.0f + f * 0.1f, 1.5f, 0.1f, 100.0f); });
+
+		//batch.hpp, per element
+		std::vector<vec3> points(array_size), scales(array_size), out3(array_size);
+		std::vector<quat> qa(array_size), qb(array_size), outq(array_size);
+		std::vector<mat4> out4(array_size);
+		std::vector<aabb> in_boxes(array_size), out_boxes(array_size);
+
+		for (std::size_t i = 0; i < array_size; ++i)
+		{
+			points[i] = random_vec3();
+			scales[i] = vec3(random(0.5f, 2), random(0.5f, 2), random(0.5f, 2));
+			qa[i] = random_quat();
+			qb[i] = random_quat();
+			in_boxes[i] = aabb(points[i] - scales[i], points[i] + scales[i]);
+		}
+
+		bench_array("transform_points(mat4)", array_size, [&] { transform_points(other4, points.data(), out3.data(), array_size); escape(out3[0]); });
+		bench_array("transform_points(affine3)", array_size, [&] { transform_points(othera, points.data(), out3.data(), array_size); escape(out3[0]); });
+		bench_array("transform_points, bounds", array_size, [&] { transform_points(other4, points.data(), out3.data(), array_size); aabb b; for (std::size_t i = 0; i < array_size; ++i) b = merge(b, out3[i]); escape(b); });
+		bench_array("transform_points_bounds", array_size, [&] { escape(transform_points_bounds(other4, points.data(), out3.data(), array_size)); });
+		bench_array("transform_aabbs(mat4)", array_size, [&] { transform_aabbs(other4, in_boxes.data(), out_boxes.data(), array_size); escape(out_boxes[0]); });
+		bench_array("slerp_many(exact)", array_size, [&] { slerp_many(qa.data(), qb.data(), 0.3f, outq.data(), array_size); escape(outq[0]); });
+		bench_array("slerp_many(fast)", array_size, [&] { slerp_many(qa.data(), qb.data(), 0.3f, outq.data(), array_size, accuracy::fast); escape(outq[0]); });
+		bench_array("nlerp_many", array_size, [&] { nlerp_many(qa.data(), qb.data(), 0.3f, outq.data(), array_size); escape(outq[0]); });
+		bench_array("compose_many", array_size, [&] { compose_many(points.data(), qa.data(), scales.data(), out4.data(), array_size); escape(out4[0]); });
+
+		std::vector<mat4> mats(array_size);
+		compose_many(points.data(), qb.data(), scales.data(), mats.data(), array_size);
+
+		bench_array("multiply_many", array_size, [&] { multiply_many(mats.data(), out4.data(), out4.data(), array_size); escape(out4[0]); });
+
+		std::vector<mat3> normals3(array_size);
+		std::vector<vec4> normals140(3 * array_size);
+
+		bench_array("normal_matrices(mat3)", array_size, [&] { normal_matrices(mats.data(), normals3.data(), array_size); escape(normals3[0]); });
+		bench_array("normal_matrices(std140)", array_size, [&] { normal_matrices(mats.data(), normals140.data(), array_size, normal_scale::direction); escape(normals140[0]); });
+
+		//per matrix; std::vector<mat4> copies with a memmove too, now that mat4 is trivially copyable
+		std::vector<mat4> mats_copy;
+
+		bench_array("copy(mat4)", array_size, [&] { copy(mats.data(), out4.data(), array_size); escape(out4[0]); });
+		bench_array("fill(mat4)", array_size, [&] { fill(out4.data(), array_size, other4); escape(out4[0]); });
+		bench_array("std::vector<mat4> copy", array_size, [&] { mats_copy = mats; escape(mats_copy[0]); mats_copy.clear(); });
+
+		//expr.hpp, per element: a + (b - a) * t over arrays and streams in one pass
+		std::vector<float> factors(array_size);
+		vec3_soa stream_a(points.data(), array_size), stream_b(scales.data(), array_size), stream_out(array_size);
+
+		for (std::size_t i = 0; i < array_size; ++i)
+			factors[i] = random(0, 1);
+
+		bench_array("assign(lerp, vec3 array)", array_size, [&] { assign(out3, lazy(points) + (lazy(scales) - lazy(points)) * lazy(factors)); escape(out3[0]); });
+		bench_array("assign(lerp, vec3_soa)", array_size, [&] { assign(stream_out, lazy(stream_a) + (lazy(stream_b) - lazy(stream_a)) * lazy(factors)); escape(stream_out.x[0]); });
+
+		//per vector
+		quat_soa stream_q(qa.data(), array_size);
+
+		bench_array("rotate_many(quat*)", array_size, [&] { rotate_many(qa.data(), points.data(), out3.data(), array_size); escape(out3[0]); });
+		bench_array("rotate_many(quat)", array_size, [&] { rotate_many(otherq, points.data(), out3.data(), array_size); escape(out3[0]); });
+		bench_array("rotate(quat_soa)", array_size, [&] { rotate(stream_q, stream_a, stream_out); escape(stream_out.x[0]); });
+
+		//frustum.hpp, per object, with points spread over [-10, 10] so part of them is visible
+		frustum view(perspective(1.0f, 1.5f, 0.1f, 100.0f) * inverse(look_at(vec3(0, 0, 12), vec3(0))));
+		vec3_soa centers(array_size), box_min(array_size), box_max(array_size);
+		std::vector<float> radii(array_size);
+		std::vector<std::uint32_t> mask((array_size + 31) / 32), indices(array_size);
+
+		for (std::size_t i = 0; i < array_size; ++i)
+		{
+			vec3 c = points[i] * 10.0f;
+			centers[i] = c;
+			box_min[i] = c - scales[i];
+			box_max[i] = c + scales[i];
+			radii[i] = length(scales[i]);
+		}
+
+		bench_array("cull_spheres", array_size, [&] { cull_spheres(view, centers, radii.data(), mask.data()); escape(mask[0]); });
+		bench_array("cull_spheres_compact", array_size, [&] { escape(cull_spheres_compact(view, centers, radii.data(), indices.data())); });
+		bench_array("cull_aabbs", array_size, [&] { cull_aabbs(view, box_min, box_max, mask.data()); escape(mask[0]); });
+		bench_array("cull_aabbs_compact", array_size, [&] { escape(cull_aabbs_compact(view, box_min, box_max, indices.data())); });
+
+		//packed.hpp, per element
+		std::vector<half3> halves(array_size);
+		std::vector<packed_quat> packed_quats(array_size);
+		std::vector<packed_normal> normals(array_size);
+
+		pack_halves(points.data(), halves.data(), array_size);
+		pack_quats(qa.data(), packed_quats.data(), array_size);
+		pack_normals(points.data(), normals.data(), array_size);
+
+		bench_array("pack_halves(vec3)", array_size, [&] { pack_halves(points.data(), halves.data(), array_size); escape(halves[0]); });
+		bench_array("unpack_halves(vec3)", array_size, [&] { unpack_halves(halves.data(), out3.data(), array_size); escape(out3[0]); });
+		bench_array("pack_quats", array_size, [&] { pack_quats(qa.data(), packed_quats.data(), array_size); escape(packed_quats[0]); });
+		bench_array("unpack_quats", array_size, [&] { unpack_quats(packed_quats.data(), outq.data(), array_size); escape(outq[0]); });
+		bench_array("pack_normals(vec3)", array_size, [&] { pack_normals(points.data(), normals.data(), array_size); escape(normals[0]); });
+		bench_array("unpack_normals(vec3)", array_size, [&] { unpack_normals(normals.data(), out3.data(), array_size); escape(out3[0]); });
+
+		//skinning.hpp, per vertex, with a palette of 64 bones
+		const std::size_t palette_size = 64;
+		std::vector<mat4> palette(palette_size);
+		std::vector<dualquat> dq_palette(palette_size);
+		std::vector<std::uint16_t> bones(8 * array_size);
+		std::vector<float> weights(8 * array_size);
+
+		for (std::size_t i = 0; i < palette_size; ++i)
+		{
+			dq_palette[i] = dualquat(random_vec3() * 10.0f, random_quat());
+			palette[i] = compose(dq_palette[i]);
+		}
+
+		for (std::size_t i = 0; i < bones.size(); ++i)
+		{
+			bones[i] = (std::uint16_t)random(0, (float)palette_size);
+			weights[i] = 1.0f / 8;
+		}
+
+		skin_influences influences4 = { bones.data(), weights.data(), 4 };
+		skin_influences influences8 = { bones.data(), weights.data(), 8 };
+		vec3_soa skin_normals(stream_b), skinned(array_size), skinned_normals(array_size);
+
+		bench_array("skin_linear(4)", array_size, [&] { skin_linear(palette.data(), influences4, stream_a, skinned); escape(skinned.x[0]); });
+		bench_array("skin_linear(4, normals)", array_size, [&] { skin_linear(palette.data(), influences4, stream_a, skin_normals, skinned, skinned_normals); escape(skinned.x[0]); });
+		bench_array("skin_linear(8)", array_size, [&] { skin_linear(palette.data(), influences8, stream_a, skinned); escape(skinned.x[0]); });
+		bench_array("skin_dual_quat(4)", array_size, [&] { skin_dual_quat(dq_palette.data(), influences4, stream_a, skinned); escape(skinned.x[0]); });
+		bench_array("skin_dual_quat(4, normals)", array_size, [&] { skin_dual_quat(dq_palette.data(), influences4, stream_a, skin_normals, skinned, skinned_normals); escape(skinned.x[0]); });
+		bench_array("skin_dual_quat(8)", array_size, [&] { skin_dual_quat(dq_palette.data(), influences8, stream_a, skinned); escape(skinned.x[0]); });
+
+		//bvh.hpp, per triangle for the build and per ray for the queries, over a cloud of small triangles
+		std::vector<vec3> triangles(3 * array_size);
+
+		for (std::size_t i = 0; i < array_size; ++i)
+		{
+			vec3 c = random_vec3() * 50.0f;
+
+			for (std::size_t k = 0; k < 3; ++k)
+				triangles[3 * i + k] = c + random_vec3();
+		}
+
+		std::vector<ray> rays(array_size);
+		std::vector<ray_hit> hits(array_size);
+		std::vector<std::uint32_t> occluded_mask((array_size + 31) / 32);
+
+		//a 64 x 64 pinhole camera in rows, so neighboring rays are coherent like in a renderer
+		for (std::size_t i = 0; i < array_size; ++i)
+			rays[i] = ray(vec3(0, 0, -120), vec3((float)(i % 64) / 64 - 0.5f, (float)(i / 64) / 64 - 0.5f, 1));
+
+		bvh tree;
+		tree.build(triangles.data(), nullptr, array_size);
+
+		bench_array("bvh::build", array_size, [&] { tree.build(triangles.data(), nullptr, array_size); escape(tree.nodes()[0]); });
+		bench_array("bvh::intersect", array_size, [&] { for (std::size_t i = 0; i < array_size; ++i) tree.intersect(rays[i], hits[i]); escape(hits[0]); });
+		bench_array("bvh::occluded", array_size, [&] { for (std::size_t i = 0; i < array_size; ++i) occluded_mask[i / 32] = tree.occluded(rays[i]); escape(occluded_mask[0]); });
+		bench_array("bvh::intersect(packets)", array_size, [&] { tree.intersect(rays.data(), hits.data(), array_size); escape(hits[0]); });
+		bench_array("bvh::occluded(packets)", array_size, [&] { tree.occluded(rays.data(), occluded_mask.data(), array_size); escape(occluded_mask[0]); });
+
+		//fastmath.hpp, per element
+		std::vector<float> angles(array_size), sines(array_size), cosines(array_size);
+
+		for (std::size_t i = 0; i < array_size; ++i)
+			angles[i] = random(-PI, PI);
+
+		bench_array("sin, cos(array)", array_size, [&] { for (std::size_t i = 0; i < array_size; ++i) { sines[i] = std::sin(angles[i]); cosines[i] = std::cos(angles[i]); } escape(sines[0]); });
+		bench_array("sincos_fast(array)", array_size, [&] { sincos_fast(angles.data(), sines.data(), cosines.data(), array_size); escape(sines[0]); });
+		bench_array("normalize(vec3_soa)", array_size, [&] { normalize(stream_a, stream_out); escape(stream_out.x[0]); });
+		bench_array("normalize_fast(vec3_soa)", array_size, [&] { normalize_fast(stream_a, stream_out); escape(stream_out.x[0]); });
+
+		//animation.hpp, per track, with 32 keys at 30 per second played forward at 60 frames per second, with
+		//cursors unless marked "search" (a binary search per track)
+		const std::size_t key_count = 32;
+		std::vector<float> key_times(key_count);
+		vec3_tracks positions, splines;
+		quat_tracks rotations;
+
+		for (std::size_t k = 0; k < key_count; ++k)
+			key_times[k] = k / 30.0f;
+
+		for (std::size_t i = 0; i < array_size; ++i)
+		{
+			std::size_t first = (i * key_count) % (array_size - key_count);
+
+			positions.add(key_times.data(), points.data() + first, key_count);
+			splines.add(key_times.data(), points.data() + first, key_count, interpolation::catmull_rom);
+			rotations.add(key_times.data(), qa.data() + first, key_count);
+		}
+
+		std::vector<std::uint32_t> cursors(array_size);
+		float clock = 0;
+
+		//returns the time of the next frame, looping over the clip
+		auto next_frame = [&] { clock += 1 / 60.0f; if (clock > positions.duration()) clock = 0; return clock; };
+
+		bench_array("sample(quat_tracks, search)", array_size, [&] { float t = next_frame(); for (std::size_t i = 0; i < array_size; ++i) outq[i] = rotations.sample(i, t); escape(outq[0]); });
+		bench_array("sample(quat_tracks)", array_size, [&] { rotations.sample(next_frame(), cursors.data(), outq.data()); escape(outq[0]); });
+		bench_array("sample(quat_tracks, fast)", array_size, [&] { rotations.sample(next_frame(), cursors.data(), outq.data(), accuracy::fast); escape(outq[0]); });
+		bench_array("sample(vec3_tracks, search)", array_size, [&] { float t = next_frame(); for (std::size_t i = 0; i < array_size; ++i) out3[i] = positions.sample(i, t); escape(out3[0]); });
+		bench_array("sample(vec3_tracks)", array_size, [&] { positions.sample(next_frame(), cursors.data(), out3.data()); escape(out3[0]); });
+		bench_array("sample(vec3_tracks, spline)", array_size, [&] { splines.sample(next_frame(), cursors.data(), out3.data()); escape(out3[0]); });
+	}
+
+	const char* config()
+	{
+#if defined(VECMATH_AVX)
+		return "avx";
+#elif defined(VECMATH_SSE)
+		return "sse";
+#else
+		return "scalar";
+#endif
+	}
+
+	void print_table()
+	{
+		std::printf("%-28s %12s %12s %12s %12s\n", "benchmark", "lat ns/op", "lat cyc/op", "tput ns/op", "tput op/cyc");
+
+		for (const result& r : results)
+		{
+			std::printf("%-28s ", r.name.c_str());
+
+			if (r.latency_ns < 0)
+				std::printf("%12s %12s ", "-", "-");
+			else if (has_cycles())
+				std::printf("%12.2f %12.2f ", r.latency_ns, r.latency_cycles);
+			else
+				std::printf("%12.2f %12s ", r.latency_ns, "-");
+
+			if (has_cycles())
+				std::printf("%12.3f %12.3f\n", r.throughput_ns, 1.0 / r.throughput_cycles);
+			else
+				std::printf("%12.3f %12s\n", r.throughput_ns, "-");
+		}
+	}
+
+	void write_number(std::FILE* f, double value)
+	{
+		if (value < 0)
+			std::fprintf(f, "null");
+		else
+			std::fprintf(f, "%.6g", value);
+	}
+
+	bool write_json(const char* path)
+	{
+		std::FILE* f = std::fopen(path, "w");
+
+		if (!f)
+			return false;
+
+		std::fprintf(f, "{\n  \"config\": {\n");
+		std::fprintf(f, "    \"simd\": \"%s\",\n", config());
+		std::fprintf(f, "    \"backend\": \"%s\",\n", backend_name(active_backend()));
+#if defined(VECMATH_HEADER_ONLY)
+		std::fprintf(f, "    \"header_only\": true,\n");
+#else
+		std::fprintf(f, "    \"header_only\": false,\n");
+#endif
+		std::fprintf(f, "    \"cycle_counter\": %s\n  },\n", has_cycles() ? "\"tsc\"" : "null");
+		std::fprintf(f, "  \"benchmarks\": [\n");
+
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			const result& r = results[i];
+			bool latency = r.latency_ns >= 0;
+
+			std::fprintf(f, "    { \"name\": \"%s\", \"latency_ns\": ", r.name.c_str());
+			write_number(f, latency ? r.latency_ns : -1);
+			std::fprintf(f, ", \"latency_cycles\": ");
+			write_number(f, latency && has_cycles() ? r.latency_cycles : -1);
+			std::fprintf(f, ", \"throughput_ns\": ");
+			write_number(f, r.throughput_ns);
+			std::fprintf(f, ", \"throughput_ops_per_cycle\": ");
+			write_number(f, has_cycles() ? 1.0 / r.throughput_cycles : -1);
+			std::fprintf(f, " }%s\n", i + 1 < results.size() ? "," : "");
+		}
+
+		std::fprintf(f, "  ]\n}\n");
+
+		return std::fclose(f) == 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* json = nullptr;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+			filter = argv[++i];
+		else if (!std::strcmp(argv[i], "--min-time") && i + 1 < argc)
+			min_time_ns = std::atof(argv[++i]) * 1e6;
+		else if (!std::strcmp(argv[i], "--json") && i + 1 < argc)
+			json = argv[++i];
+		else if (!std::strcmp(argv[i], "--backend") && i + 1 < argc)
+		{
+			const char* name = argv[++i];
+			bool found = false;
+
+			for (backend b : { backend::scalar, backend::sse2, backend::avx2 })
+			{
+				if (!std::strcmp(name, backend_name(b)))
+				{
+					found = true;
+
+					if (!set_backend(b))
+					{
+						std::fprintf(stderr, "backend %s isn't supported by this build or cpu\n", name);
+						return 1;
+					}
+				}
+			}
+
+			if (!found)
+			{
+				std::fprintf(stderr, "unknown backend %s\n", name);
+				return 1;
+			}
+		}
+		else
+		{
+			std::fprintf(stderr, "usage: %s [--filter <substring>] [--min-time <ms>] [--json <file>] [--backend scalar|sse2|avx2]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	std::printf("vecmath_bench (%s, %s array kernels)\n\n", config(), backend_name(active_backend()));
+
+	run_all();
+	print_table();
+
+	if (json && !write_json(json))
+	{
+		std::fprintf(stderr, "could not write %s\n", json);
+		return 1;
+	}
+
+	return 0;
+}
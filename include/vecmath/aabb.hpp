@@ -0,0 +1,126 @@
+#ifndef VECMATH_AABB_H
+#define VECMATH_AABB_H
+
+#include "affine.hpp"
+
+#include <limits>
+
+namespace vcm
+{
+	//axis aligned bounding box from 'min' to 'max' (inclusive)
+	//a box with any component of 'min' greater than that of 'max' is empty
+	struct aabb
+	{
+		//creates an empty box (min = +infinity, max = -infinity), which merge() grows from nothing
+		constexpr aabb();
+
+		//creates the box from 'min' to 'max'
+		constexpr aabb(const vec3& min, const vec3& max);
+
+		//creates a box from an existing box
+		constexpr aabb(const aabb& other) = default;
+
+		constexpr bool operator==(const aabb& other) const { return min == other.min && max == other.max; }
+		constexpr bool operator!=(const aabb& other) const { return min != other.min || max != other.max; }
+
+		constexpr aabb& operator=(const aabb& other) = default;
+
+		vec3 min;
+		vec3 max;
+	};
+
+	//returns whether 'b' contains no points
+	constexpr bool empty(const aabb& b);
+
+	//returns the center of 'b'
+	constexpr vec3 center(const aabb& b);
+
+	//returns half the size of 'b' along each axis
+	constexpr vec3 extents(const aabb& b);
+
+	//returns whether the point 'p' is inside 'b'
+	constexpr bool contains(const aabb& b, const vec3& p);
+
+	//returns whether 'inner' lies completely inside 'outer'; an empty 'inner' is inside every box
+	constexpr bool contains(const aabb& outer, const aabb& inner);
+
+	//returns whether 'a' and 'b' share at least one point
+	constexpr bool overlaps(const aabb& a, const aabb& b);
+
+	//returns the smallest box containing both 'a' and 'b' (their union)
+	aabb merge(const aabb& a, const aabb& b);
+
+	//returns the smallest box containing both 'b' and the point 'p'
+	aabb merge(const aabb& b, const vec3& p);
+
+	//returns the box shared by 'a' and 'b', which is empty if they don't overlap
+	aabb intersection(const aabb& a, const aabb& b);
+
+	//returns the smallest box containing 'b' transformed by the affine matrix 'm' (the bottom row is ignored)
+	//transforms the center and the extents (arvo) instead of all eight corners; empty boxes stay empty
+	aabb transform(const mat4& m, const aabb& b);
+
+	//returns the smallest box containing 'b' transformed by 'a'
+	aabb transform(const affine3& a, const aabb& b);
+
+	//LAYOUT
+
+	VECMATH_LAYOUT(aabb, 6);
+
+    //INLINE CONSTRUCTORS
+
+    //AABB
+
+    constexpr aabb::aabb() :
+        min(std::numeric_limits<float>::infinity()),
+        max(-std::numeric_limits<float>::infinity())
+    {
+    }
+
+    constexpr aabb::aabb(const vec3& min, const vec3& max) : min(min), max(max) {}
+
+
+    //CONSTEXPR FUNCTIONS
+
+    constexpr bool empty(const aabb& b)
+    {
+        return b.min.x > b.max.x || b.min.y > b.max.y || b.min.z > b.max.z;
+    }
+
+    constexpr vec3 center(const aabb& b)
+    {
+        return (b.min + b.max) * 0.5f;
+    }
+
+    constexpr vec3 extents(const aabb& b)
+    {
+        return (b.max - b.min) * 0.5f;
+    }
+
+    constexpr bool contains(const aabb& b, const vec3& p)
+    {
+        return p.x >= b.min.x && p.y >= b.min.y && p.z >= b.min.z &&
+               p.x <= b.max.x && p.y <= b.max.y && p.z <= b.max.z;
+    }
+
+    constexpr bool contains(const aabb& outer, const aabb& inner)
+    {
+        if (empty(inner))
+            return true;
+
+        return inner.min.x >= outer.min.x && inner.min.y >= outer.min.y && inner.min.z >= outer.min.z &&
+               inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+    }
+
+    constexpr bool overlaps(const aabb& a, const aabb& b)
+    {
+        return a.min.x <= b.max.x && a.min.y <= b.max.y && a.min.z <= b.max.z &&
+               b.min.x <= a.max.x && b.min.y <= a.max.y && b.min.z <= a.max.z;
+    }
+}
+
+#ifdef VECMATH_HEADER_ONLY
+#include "aabb.inl"
+#endif
+
+#endif
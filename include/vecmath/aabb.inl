@@ -0,0 +1,58 @@
+#ifndef VECMATH_AABB_INL
+#define VECMATH_AABB_INL
+
+//definitions of the functions declared in aabb.hpp
+//included by aabb.hpp when VECMATH_HEADER_ONLY is defined, otherwise compiled into src/aabb.cpp
+
+#include "aabb.hpp"
+
+#include <cmath>
+
+namespace vcm
+{
+	VECMATH_INLINE aabb merge(const aabb& a, const aabb& b)
+	{
+		return { min(a.min, b.min), max(a.max, b.max) };
+	}
+
+	VECMATH_INLINE aabb merge(const aabb& b, const vec3& p)
+	{
+		return { min(b.min, p), max(b.max, p) };
+	}
+
+	VECMATH_INLINE aabb intersection(const aabb& a, const aabb& b)
+	{
+		return { max(a.min, b.min), min(a.max, b.max) };
+	}
+
+	VECMATH_INLINE aabb transform(const mat4& m, const aabb& b)
+	{
+		//the center of an empty box is nan, so it is returned as it is
+		if (empty(b))
+			return b;
+
+		vec3 c = center(b);
+		vec3 e = extents(b);
+
+		vec3 c0 = vec3(m.m[0]);
+		vec3 c1 = vec3(m.m[1]);
+		vec3 c2 = vec3(m.m[2]);
+
+		//the extent along each axis is the sum of the absolute column contributions
+		vec3 a0 = { std::fabs(c0.x), std::fabs(c0.y), std::fabs(c0.z) };
+		vec3 a1 = { std::fabs(c1.x), std::fabs(c1.y), std::fabs(c1.z) };
+		vec3 a2 = { std::fabs(c2.x), std::fabs(c2.y), std::fabs(c2.z) };
+
+		vec3 tc = c0 * c.x + c1 * c.y + c2 * c.z + vec3(m.m[3]);
+		vec3 te = a0 * e.x + a1 * e.y + a2 * e.z;
+
+		return { tc - te, tc + te };
+	}
+
+	VECMATH_INLINE aabb transform(const affine3& a, const aabb& b)
+	{
+		return transform(mat4(a), b);
+	}
+}
+
+#endif
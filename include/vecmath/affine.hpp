@@ -0,0 +1,127 @@
+#ifndef VECMATH_AFFINE_H
+#define VECMATH_AFFINE_H
+
+#include "matrix.hpp"
+
+namespace vcm
+{
+	//affine transform: a 3x4 matrix with an implicit bottom row of (0, 0, 0, 1)
+	//holds the same transforms as compose() in 48 bytes instead of 64
+	struct affine3
+	{
+		//creates an identity transform
+		constexpr affine3();
+
+		//creates a transform with the rotation * scale columns 'a', 'b', and 'c', and the translation 't'
+		constexpr affine3(const vec3& a, const vec3& b, const vec3& c, const vec3& t);
+
+		//creates a transform from the rotation * scale matrix 'rs' and the translation 't'
+		constexpr affine3(const mat3& rs, const vec3& t);
+
+		//creates a transform from an existing transform
+		constexpr affine3(const affine3& other) = default;
+
+		//creates a transform from the upper 3x4 part of 'other'; the bottom row is ignored
+		explicit constexpr affine3(const mat4& other);
+
+		constexpr vec3& operator[](unsigned i) { return m[i]; }
+		constexpr vec3 operator[](unsigned i) const { return m[i]; }
+
+		constexpr bool operator==(const affine3& other) const { return m[0] == other.m[0] && m[1] == other.m[1] && m[2] == other.m[2] && m[3] == other.m[3]; }
+		constexpr bool operator!=(const affine3& other) const { return m[0] != other.m[0] || m[1] != other.m[1] || m[2] != other.m[2] || m[3] != other.m[3]; }
+
+		//returns the transform that applies 'other' first and then this transform
+		affine3 operator*(const affine3& other) const;
+
+		constexpr affine3& operator=(const affine3& other) = default;
+
+		affine3& operator*=(const affine3& other) 
+		{
+			return (*this = (*this * other));
+		}
+
+		vec3 m[4]; //columns; m[3] is the translation
+	};
+
+	//returns the point 'p' transformed by 'a'
+	vec3 transform_point(const affine3& a, const vec3& p);
+
+	//returns the direction vector 'v' transformed by 'a' (the translation is not applied)
+	vec3 transform_vector(const affine3& a, const vec3& v);
+
+	//returns the inverse of 'a'
+	affine3 inverse(const affine3& a);
+
+	//creates an affine transform (translation * rotation) from 'tran' and 'rot'
+	affine3 compose_affine(const vec3& tran, const quat& rot);
+
+	//creates an affine transform (translation * rotation * scale) from 'tran', 'rot', and 'scale'
+	affine3 compose_affine(const vec3& tran, const quat& rot, const vec3& scale);
+
+	//returns the normal matrix of the linear part of 'a' (see normal_matrix(const mat3&))
+	constexpr mat3 normal_matrix(const affine3& a, normal_scale scale = normal_scale::exact);
+
+	//LAYOUT
+
+	VECMATH_LAYOUT(affine3, 12);
+
+    //INLINE CONSTRUCTORS
+
+    //AFFINE3
+
+    constexpr affine3::affine3()
+    {
+        m[0] = { 1, 0, 0 };
+        m[1] = { 0, 1, 0 };
+        m[2] = { 0, 0, 1 };
+        m[3] = { 0, 0, 0 };
+    }
+
+    constexpr affine3::affine3(const vec3& a, const vec3& b, const vec3& c, const vec3& t)
+    {
+        m[0] = a;
+        m[1] = b;
+        m[2] = c;
+        m[3] = t;
+    }
+
+    constexpr affine3::affine3(const mat3& rs, const vec3& t)
+    {
+        m[0] = rs.m[0];
+        m[1] = rs.m[1];
+        m[2] = rs.m[2];
+        m[3] = t;
+    }
+
+
+    constexpr affine3::affine3(const mat4& other)
+    {
+        m[0] = (vcm::vec3)other.m[0];
+        m[1] = (vcm::vec3)other.m[1];
+        m[2] = (vcm::vec3)other.m[2];
+        m[3] = (vcm::vec3)other.m[3];
+    }
+
+    //MAT4
+
+    constexpr mat4::mat4(const affine3& other)
+    {
+        m[0] = { other.m[0], 0 };
+        m[1] = { other.m[1], 0 };
+        m[2] = { other.m[2], 0 };
+        m[3] = { other.m[3], 1 };
+    }
+
+    //CONSTEXPR FUNCTIONS
+
+    constexpr mat3 normal_matrix(const affine3& a, normal_scale scale)
+    {
+        return normal_matrix(mat3(a.m[0], a.m[1], a.m[2]), scale);
+    }
+}
+
+#ifdef VECMATH_HEADER_ONLY
+#include "affine.inl"
+#endif
+
+#endif
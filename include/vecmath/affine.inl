@@ -0,0 +1,72 @@
+#ifndef VECMATH_AFFINE_INL
+#define VECMATH_AFFINE_INL
+
+//definitions of the functions declared in affine.hpp
+//included by affine.hpp when VECMATH_HEADER_ONLY is defined, otherwise compiled into src/affine.cpp
+
+#include "affine.hpp"
+
+namespace vcm
+{
+	VECMATH_INLINE affine3 affine3::operator*(const affine3& other) const 
+	{
+		affine3 result;
+
+		result.m[0] = m[0] * other.m[0].x + m[1] * other.m[0].y + m[2] * other.m[0].z;
+		result.m[1] = m[0] * other.m[1].x + m[1] * other.m[1].y + m[2] * other.m[1].z;
+		result.m[2] = m[0] * other.m[2].x + m[1] * other.m[2].y + m[2] * other.m[2].z;
+		result.m[3] = m[0] * other.m[3].x + m[1] * other.m[3].y + m[2] * other.m[3].z + m[3];
+
+		return result;
+	}
+
+	VECMATH_INLINE vec3 transform_point(const affine3& a, const vec3& p) 
+	{
+		return a.m[0] * p.x + a.m[1] * p.y + a.m[2] * p.z + a.m[3];
+	}
+
+	VECMATH_INLINE vec3 transform_vector(const affine3& a, const vec3& v) 
+	{
+		return a.m[0] * v.x + a.m[1] * v.y + a.m[2] * v.z;
+	}
+
+	VECMATH_INLINE affine3 inverse(const affine3& a) 
+	{
+		//the rows of the inverse 3x3 block are the cross products of the columns over the determinant
+		vec3 r0 = cross(a.m[1], a.m[2]);
+		vec3 r1 = cross(a.m[2], a.m[0]);
+		vec3 r2 = cross(a.m[0], a.m[1]);
+
+		float dt = dot(a.m[0], r0);
+		if (dt == 0)
+			return a;
+
+		float inv = 1.0f / dt;
+		r0 *= inv;
+		r1 *= inv;
+		r2 *= inv;
+
+		affine3 result;
+
+		result.m[0] = { r0.x, r1.x, r2.x };
+		result.m[1] = { r0.y, r1.y, r2.y };
+		result.m[2] = { r0.z, r1.z, r2.z };
+		result.m[3] = { -dot(r0, a.m[3]), -dot(r1, a.m[3]), -dot(r2, a.m[3]) };
+
+		return result;
+	}
+
+	VECMATH_INLINE affine3 compose_affine(const vec3& tran, const quat& rot) 
+	{
+		return affine3(mat3(rot), tran);
+	}
+
+	VECMATH_INLINE affine3 compose_affine(const vec3& tran, const quat& rot, const vec3& scale) 
+	{
+		mat3 rs(rot);
+
+		return affine3(rs.m[0] * scale.x, rs.m[1] * scale.y, rs.m[2] * scale.z, tran);
+	}
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef VECMATH_ANIMATION_H
+#define VECMATH_ANIMATION_H
+
+#include "batch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vcm
+{
+	//KEYFRAME TRACKS
+
+	//how a track interpolates between its keys
+	enum class interpolation
+	{
+		step,       //the value of the last key at or before the time
+		linear,     //lerp() for vec3, slerp() for quat
+		cubic,      //cubic hermite spline through the keys with the tangents given to add()
+		catmull_rom //cubic hermite spline with the tangents taken from the neighboring keys
+	};
+
+	//set of keyframe tracks sampled together, e.g. the positions or rotations of the bones of a clip
+	//the keys of every track are stored back to back, with the times and the values in separate arrays,
+	//so a pass over all tracks reads memory in order and the key searches only touch the times
+	//outside its first and last key a track holds the value of that key (loop by wrapping the time)
+	//
+	//sampling with a cursor per track (one std::uint32_t, zero for a new instance) starts the key search
+	//where the last sample of that instance ended, so playing forward costs O(1) per sample instead of a
+	//binary search; jumps and backwards playback still work, with a binary search
+	//
+	//    std::vector<std::uint32_t> cursors(rotations.size()); //per playing instance
+	//    rotations.sample(time, cursors.data(), bone_rotations);
+	template <typename T>
+	struct keyframe_tracks
+	{
+		//creates an empty set of tracks
+		keyframe_tracks();
+
+		//adds a track of the 'n' (at least one) keys 'values' at the strictly increasing 'times' and returns its index
+		//'tangents' are the derivatives at the keys per unit of time, read for interpolation::cubic only; a cubic
+		//track without them takes the tangents of interpolation::catmull_rom
+		//quaternion keys are stored negated where needed to be in the hemisphere of the previous key, which
+		//describes the same rotations and keeps the cubic splines on the shorter arcs
+		std::size_t add(const float* times, const T* values, std::size_t n, interpolation mode = interpolation::linear, const T* tangents = nullptr);
+
+		//removes every track
+		void clear();
+
+		//returns track 'i' at time 't', finding the key with a binary search
+		T sample(std::size_t i, float t) const;
+
+		//returns track 'i' at time 't', starting the key search at 'cursor' and updating it
+		T sample(std::size_t i, float t, std::uint32_t& cursor) const;
+
+		//writes every track at time 't' to 'out', with the cursors 'cursors' (one per track, or null for binary
+		//searches); the linear tracks are gathered and interpolated across simd lanes with lerp / slerp_many(),
+		//in 'mode' for quaternions (accuracy::fast is within 1e-6 of slerp(), see slerp_many())
+		void sample(float t, std::uint32_t* cursors, T* out, accuracy mode = accuracy::exact) const;
+
+		//returns the number of tracks
+		std::size_t size() const { return tracks.size(); }
+
+		//returns the time of the last key of the longest track, 0 without tracks
+		float duration() const { return end_time; }
+
+		//returns the number of keys of track 'i'
+		std::size_t keys(std::size_t i) const { return tracks[i].count; }
+
+		//returns the key times of track 'i'
+		const float* times(std::size_t i) const { return key_times.data() + tracks[i].first; }
+
+		//returns the key values of track 'i'
+		const T* values(std::size_t i) const { return key_values.data() + tracks[i].first; }
+
+		//returns how track 'i' interpolates
+		interpolation mode(std::size_t i) const { return tracks[i].mode; }
+
+	private:
+		struct track
+		{
+			std::uint32_t first;    //the first key in 'key_times' and 'key_values'
+			std::uint32_t count;    //the number of keys
+			std::uint32_t tangents; //the tangent of the first key in 'key_tangents' (cubic and catmull_rom only)
+			interpolation mode;
+		};
+
+		//returns the key starting the segment of 'tr' that holds 't', which is between the first and last keys,
+		//starting at 'cursor' (less than the number of segments)
+		std::uint32_t find(const track& tr, float t, std::uint32_t cursor) const;
+
+		//returns 'tr' at time 't' in the segment starting at key 'k'
+		T evaluate(const track& tr, float t, std::uint32_t k) const;
+
+		std::vector<track> tracks;
+		std::vector<float> key_times;
+		std::vector<T> key_values;
+		std::vector<T> key_tangents;
+		float end_time;
+	};
+
+	using vec3_tracks = keyframe_tracks<vec3>;
+	using quat_tracks = keyframe_tracks<quat>;
+
+	//defined in animation.cpp for vec3 and quat
+	extern template struct keyframe_tracks<vec3>;
+	extern template struct keyframe_tracks<quat>;
+}
+
+#endif
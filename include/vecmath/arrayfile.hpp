@@ -0,0 +1,221 @@
+#ifndef VECMATH_ARRAYFILE_H
+#define VECMATH_ARRAYFILE_H
+
+#include "aabb.hpp"
+#include "dualquat.hpp"
+#include "packed.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace vcm
+{
+	//ARRAY FILES
+	//a binary container of named arrays of vecmath types, e.g. the tracks of a clip or the instances of a
+	//level, written by array_writer and memory mapped by array_file, which hands out pointers into the
+	//mapping instead of parsing the arrays into memory of their own; pages are only read when touched and
+	//are shared with the file cache
+	//
+	//layout, in the byte order of the writer: a 64 byte header ("VCMARRAY", format version, byte order tag,
+	//alignment, array count, directory offset, file size), then the data of each array at an offset that is
+	//a multiple of the alignment, then the directory of 96 byte entries (name, type, encoding, stride, count,
+	//offset, size); files of another major version or byte order are rejected, not misread
+
+	//the type of the elements of an array, as stored in the file
+	enum class array_type : std::uint32_t
+	{
+		f32 = 1, u16, u32, vec2, vec3, vec4, quat, mat2, mat3, mat4, affine3, dualquat, aabb
+	};
+
+	//how the elements are stored
+	enum class array_encoding : std::uint32_t
+	{
+		raw,            //the elements as they are in memory
+		half,           //half3 / half4 for vec3 / vec4 arrays (pack_half())
+		smallest_three, //packed_quat for quat arrays (pack_quat())
+		snorm10         //packed_normal for vec3 and vec4 arrays (pack_normal())
+	};
+
+	//the type and encoding of the arrays of 'T', for the types that can be stored as they are
+	template <typename T>
+	struct array_format;
+
+#define VECMATH_ARRAY_FORMAT(T, t, e) \
+	template <> struct array_format<T> { static const array_type type = array_type::t; static const array_encoding encoding = array_encoding::e; }
+
+	VECMATH_ARRAY_FORMAT(float, f32, raw);
+	VECMATH_ARRAY_FORMAT(std::uint16_t, u16, raw);
+	VECMATH_ARRAY_FORMAT(std::uint32_t, u32, raw);
+	VECMATH_ARRAY_FORMAT(vec2, vec2, raw);
+	VECMATH_ARRAY_FORMAT(vec3, vec3, raw);
+	VECMATH_ARRAY_FORMAT(vec4, vec4, raw);
+	VECMATH_ARRAY_FORMAT(quat, quat, raw);
+	VECMATH_ARRAY_FORMAT(mat2, mat2, raw);
+	VECMATH_ARRAY_FORMAT(mat3, mat3, raw);
+	VECMATH_ARRAY_FORMAT(mat4, mat4, raw);
+	VECMATH_ARRAY_FORMAT(affine3, affine3, raw);
+	VECMATH_ARRAY_FORMAT(dualquat, dualquat, raw);
+	VECMATH_ARRAY_FORMAT(aabb, aabb, raw);
+	VECMATH_ARRAY_FORMAT(half3, vec3, half);
+	VECMATH_ARRAY_FORMAT(half4, vec4, half);
+	VECMATH_ARRAY_FORMAT(packed_quat, quat, smallest_three);
+	VECMATH_ARRAY_FORMAT(packed_normal, vec4, snorm10); //spans of packed_normal also cover vec3 arrays
+
+#undef VECMATH_ARRAY_FORMAT
+
+	//an array in an array_file
+	struct array_info
+	{
+		const char* name;        //at most 47 characters
+		array_type type;
+		array_encoding encoding;
+		std::size_t count;       //elements
+		std::size_t stride;      //bytes per stored element
+		std::uint64_t offset;    //bytes from the start of the file
+	};
+
+	//view of the elements of an array in a mapped file
+	template <typename T>
+	struct array_span
+	{
+		const T* data;
+		std::size_t count;
+
+		bool empty() const { return count == 0; }
+		std::size_t size() const { return count; }
+		const T* begin() const { return data; }
+		const T* end() const { return data + count; }
+		const T& operator[](std::size_t i) const { return data[i]; }
+	};
+
+	//writes an array file, streaming each array to the file as it is added
+	//the functions return false once a write fails (or for invalid arguments), and the file is only complete
+	//after close() returned true
+	struct array_writer
+	{
+		//the current version of the format; files of the same major version (version >> 16) can be read
+		static const std::uint32_t version = 0x00010000;
+
+		//creates a writer without a file
+		array_writer();
+
+		//closes the file, like close()
+		~array_writer();
+
+		array_writer(const array_writer&) = delete;
+		array_writer& operator=(const array_writer&) = delete;
+
+		//creates the file at 'path', replacing it, with the arrays aligned to 'alignment' bytes (a power of two
+		//from 16 to 65536; 64 keeps every array on its own cache lines, 4096 on its own pages)
+		bool open(const char* path, std::size_t alignment = 64);
+
+		//appends the 'n' elements 'data' as the array 'name' (at most 47 characters, unique in the file)
+		//any type with an array_format can be written, the packed types as arrays of their encoding
+		template <typename T>
+		bool write(const char* name, const T* data, std::size_t n) { return write_array(name, array_format<T>::type, array_format<T>::encoding, data, n); }
+
+		//appends the 'n' elements 'data' as the array 'name', encoded with 'encoding' with the bulk functions of
+		//packed.hpp: half or snorm10 for vectors, smallest_three for quaternions (raw writes them as they are)
+		bool write(const char* name, const vec3* data, std::size_t n, array_encoding encoding);
+		bool write(const char* name, const vec4* data, std::size_t n, array_encoding encoding);
+		bool write(const char* name, const quat* data, std::size_t n, array_encoding encoding);
+
+		//writes the directory and the header and closes the file; returns whether every write succeeded
+		bool close();
+
+	private:
+		//writes 'n' elements of 'type' stored as 'encoding' from 'data' (already encoded)
+		bool write_array(const char* name, array_type type, array_encoding encoding, const void* data, std::size_t n);
+
+		//starts the entry for an array at the next multiple of the alignment and returns whether that succeeded
+		bool begin_array(const char* name, array_type type, array_encoding encoding, std::size_t n);
+
+		//encodes the 'n' elements 'data' with 'encode' a chunk at a time and writes them
+		template <typename In, typename Out>
+		bool write_encoded(const In* data, std::size_t n, void (*encode)(const In*, Out*, std::size_t));
+
+		//writes zeros up to the next multiple of the alignment
+		bool pad();
+
+		//writes 'size' bytes to the file
+		bool write_bytes(const void* data, std::size_t size);
+
+		std::FILE* file;
+		std::uint64_t position;
+		std::size_t alignment;
+		std::vector<unsigned char> directory;
+		bool failed;
+	};
+
+	//array file mapped into memory read-only
+	//the spans point into the mapping and stay valid until close() or destruction
+	struct array_file
+	{
+		//creates an empty file, with no arrays
+		array_file();
+
+		//unmaps the file
+		~array_file();
+
+		array_file(const array_file&) = delete;
+		array_file& operator=(const array_file&) = delete;
+
+		//maps the file at 'path' and reads its directory; returns false (leaving the file closed) if it can't
+		//be mapped, isn't an array file, has an unsupported version or byte order, or is truncated or corrupt
+		bool open(const char* path);
+
+		//unmaps the file
+		void close();
+
+		//returns the number of arrays
+		std::size_t size() const { return arrays.size(); }
+
+		//returns array 'i', in the order they were written
+		const array_info& info(std::size_t i) const { return arrays[i]; }
+
+		//returns the array called 'name', or null
+		const array_info* find(const char* name) const;
+
+		//returns the elements of the array 'name' without copying them, or an empty span (null data) if there
+		//is no such array or it isn't stored as an array of 'T' (e.g. span<half3>() for a vec3 array in half)
+		template <typename T>
+		array_span<T> span(const char* name) const
+		{
+			std::size_t count = 0;
+			const void* data = find_data(name, array_format<T>::type, array_format<T>::encoding, sizeof(T), count);
+
+			return { (const T*)data, count };
+		}
+
+		//copies the array 'name' of 'T' elements into 'out', which must hold find(name)->count elements, decoding
+		//it with the bulk functions of packed.hpp if it is encoded; returns false if there is no such array or it
+		//holds another type
+		template <typename T>
+		bool read(const char* name, T* out) const
+		{
+			static_assert(array_format<T>::encoding == array_encoding::raw, "read() decodes into the full precision types");
+			return read_array(name, array_format<T>::type, out);
+		}
+
+		//tells the os that the array 'name' will be read soon, so its pages are read ahead of the first access
+		void prefetch(const char* name) const;
+
+	private:
+		//returns the data of the array 'name' if it has 'type' (any vector type for snorm10) and 'encoding'
+		//and elements of 'stride' bytes, writing the count to 'count'; null otherwise
+		const void* find_data(const char* name, array_type type, array_encoding encoding, std::size_t stride, std::size_t& count) const;
+
+		//decodes the array 'name' if it has 'type' into 'out'
+		bool read_array(const char* name, array_type type, void* out) const;
+
+		const unsigned char* base;
+		std::size_t length;
+		std::vector<array_info> arrays;
+
+		void* handle; //the file mapping object on windows
+	};
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef VECMATH_BACKEND_H
+#define VECMATH_BACKEND_H
+
+namespace vcm
+{
+	//RUNTIME DISPATCH
+	//the array functions (batch.hpp, soa.hpp, frustum.hpp, packed.hpp, skinning.hpp, fastmath.hpp, pointstream.hpp,
+	//and the ray packets of bvh.hpp) are compiled for each backend and run with the best one the cpu supports,
+	//chosen with cpuid the first time one of them is called
+	//the environment variable VECMATH_BACKEND ("scalar", "sse2", or "avx2") picks another one at that
+	//point, and set_backend() at any time, e.g. to compare their speed or to rule out a simd kernel
+	//results may differ between backends in the last bits, since avx2 fuses multiply-adds
+	//the single element functions (vector.hpp, matrix.hpp, ...) aren't dispatched: they are inlined into
+	//the caller, with the instruction set chosen at compile time by VECMATH_SSE and VECMATH_AVX
+
+	enum class backend
+	{
+		scalar, //portable code, one element at a time
+		sse2,   //4 lanes, on every x86-64 cpu
+		avx2    //8 lanes with fused multiply-adds and F16C half conversions (also used on AVX-512 cpus)
+	};
+
+	//returns the backend the array functions use
+	backend active_backend();
+
+	//returns whether 'b' is built into the library (sse2 and avx2 are x86 only, and need VECMATH_SSE)
+	//and supported by the cpu
+	bool backend_supported(backend b);
+
+	//makes the array functions use 'b', returning false and keeping the current backend if 'b' isn't supported
+	//each call of an array function uses a single backend, even when the backend is switched meanwhile
+	bool set_backend(backend b);
+
+	//returns the name of 'b', as used by VECMATH_BACKEND
+	const char* backend_name(backend b);
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef VECMATH_BATCH_H
+#define VECMATH_BATCH_H
+
+#include "aabb.hpp"
+#include "affine.hpp"
+#include "soa.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace vcm
+{
+	//ARRAY OPERATIONS
+	//these work on contiguous arrays of 'n' elements, several elements per iteration
+	//'in' and 'out' may be the same array, but must not otherwise overlap
+
+	//transforms the points 'in' by 'm' (w = 1) and writes them to 'out'
+	//the w component of the result is discarded; no perspective divide is done
+	void transform_points(const mat4& m, const vec3* in, vec3* out, std::size_t n);
+
+	//transforms the points 'points' by 'm' (w = 1) in place
+	void transform_points(const mat4& m, vec3* points, std::size_t n);
+
+	//transforms the direction vectors 'in' by 'm' (w = 0) and writes them to 'out'
+	void transform_vectors(const mat4& m, const vec3* in, vec3* out, std::size_t n);
+
+	//transforms the direction vectors 'vectors' by 'm' (w = 0) in place
+	void transform_vectors(const mat4& m, vec3* vectors, std::size_t n);
+
+	//transforms the points 'in' by 'a' and writes them to 'out'
+	void transform_points(const affine3& a, const vec3* in, vec3* out, std::size_t n);
+
+	//transforms the points 'points' by 'a' in place
+	void transform_points(const affine3& a, vec3* points, std::size_t n);
+
+	//transforms the direction vectors 'in' by 'a' and writes them to 'out'
+	void transform_vectors(const affine3& a, const vec3* in, vec3* out, std::size_t n);
+
+	//transforms the direction vectors 'vectors' by 'a' in place
+	void transform_vectors(const affine3& a, vec3* vectors, std::size_t n);
+
+	//writes transform(m, in[i]) for each of the 'n' boxes to 'out'; 'm' must be affine
+	void transform_aabbs(const mat4& m, const aabb* in, aabb* out, std::size_t n);
+
+	//transforms the boxes 'boxes' by 'm' in place
+	void transform_aabbs(const mat4& m, aabb* boxes, std::size_t n);
+
+	//writes transform(a, in[i]) for each of the 'n' boxes to 'out'
+	void transform_aabbs(const affine3& a, const aabb* in, aabb* out, std::size_t n);
+
+	//transforms the boxes 'boxes' by 'a' in place
+	void transform_aabbs(const affine3& a, aabb* boxes, std::size_t n);
+
+	//writes a[i] * b[i] for each of the 'n' pairs of matrices to 'out', which may be 'a' or 'b'
+	void multiply_many(const mat4* a, const mat4* b, mat4* out, std::size_t n);
+
+	//writes normal_matrix(in[i], scale) for each of the 'n' matrices to 'out'
+	void normal_matrices(const mat4* in, mat3* out, std::size_t n, normal_scale scale = normal_scale::exact);
+	void normal_matrices(const affine3* in, mat3* out, std::size_t n, normal_scale scale = normal_scale::exact);
+
+	//writes normal_matrix(in[i], scale) for each of the 'n' matrices to 'out' as three vec4 columns with w = 0,
+	//the std140 layout of a mat3 in a uniform or storage buffer; 'out' must hold 3 * n vec4s
+	void normal_matrices(const mat4* in, vec4* out, std::size_t n, normal_scale scale = normal_scale::exact);
+	void normal_matrices(const affine3* in, vec4* out, std::size_t n, normal_scale scale = normal_scale::exact);
+
+	//accuracy of the array interpolation functions
+	enum class accuracy
+	{
+		exact, //the same results as the single element functions
+		fast   //polynomial approximations across simd lanes, see each function for the error bound
+	};
+
+	//writes slerp(a[i], b[i], t) for each of the 'n' pairs of quaternions to 'out'
+	//accuracy::fast corrects the sign without branching, approximates acos and sin with polynomials,
+	//and always normalizes; each component is within 1e-6 of slerp() for unit quaternions
+	void slerp_many(const quat* a, const quat* b, float t, quat* out, std::size_t n, accuracy mode = accuracy::exact);
+
+	//writes slerp(a[i], b[i], t[i]) for each of the 'n' pairs of quaternions to 'out'
+	void slerp_many(const quat* a, const quat* b, const float* t, quat* out, std::size_t n, accuracy mode = accuracy::exact);
+
+	//writes 'a[i]' and 'b[i]' interpolated by a factor of 't' along the shorter arc, normalized, to 'out'
+	//(lerp(a[i], b[i], t) with 'b[i]' negated when dot(a[i], b[i]) < 0)
+	void nlerp_many(const quat* a, const quat* b, float t, quat* out, std::size_t n);
+
+	//writes 'a[i]' and 'b[i]' interpolated by a factor of 't[i]' along the shorter arc, normalized, to 'out'
+	void nlerp_many(const quat* a, const quat* b, const float* t, quat* out, std::size_t n);
+
+	//writes rotate(q[i], in[i]) for each of the 'n' vectors to 'out'; the quaternions must be normalized
+	void rotate_many(const quat* q, const vec3* in, vec3* out, std::size_t n);
+
+	//writes inverse_rotate(q[i], in[i]) for each of the 'n' vectors to 'out'
+	void inverse_rotate_many(const quat* q, const vec3* in, vec3* out, std::size_t n);
+
+	//writes rotate(q, in[i]) for each of the 'n' vectors to 'out'; 'q' is turned into a matrix once, so this
+	//runs like transform_vectors()
+	void rotate_many(const quat& q, const vec3* in, vec3* out, std::size_t n);
+
+	//writes compose(tran[i], rot[i], scale[i]) for each of the 'n' transforms to 'out'
+	//the work is split across up to 'threads' threads (0 means one per hardware thread) when 'n' is large
+	void compose_many(const vec3* tran, const quat* rot, const vec3* scale, mat4* out, std::size_t n, unsigned threads = 1);
+
+	//writes compose(tran[i], rot[i], scale[i]) for each transform in the streams to 'out'
+	//the streams must be the same size and 'out' must hold that many matrices
+	void compose_many(const vec3_soa& tran, const quat_soa& rot, const vec3_soa& scale, mat4* out, unsigned threads = 1);
+
+	//BULK COPIES
+	//the vecmath types are trivially copyable (VECMATH_LAYOUT in config.hpp), so whole arrays of them are
+	//moved as bytes instead of element by element
+
+	//copies the 'n' elements 'in' to 'out' with one memmove; unlike the functions above, the arrays may overlap
+	template <typename T>
+	void copy(const T* in, T* out, std::size_t n)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "copy() needs a trivially copyable type");
+
+		if (n > 0)
+			std::memmove(out, in, n * sizeof(T));
+	}
+
+	//sets the 'n' elements 'out' to 'value'; the compiler turns the loop into wide stores, which is faster
+	//than filling with memcpy since nothing is read back
+	template <typename T>
+	void fill(T* out, std::size_t n, const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "fill() needs a trivially copyable type");
+
+		T v = value;
+
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = v;
+	}
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef VECMATH_BVH_H
+#define VECMATH_BVH_H
+
+#include "aabb.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace vcm
+{
+	//RAYS
+
+	//ray from 'origin' along 'direction', which hits between the distances 0 and 'length'
+	//distances are in units of 'direction', which doesn't need to be normalized
+	struct ray
+	{
+		//creates a ray at the origin with a zero direction and length
+		constexpr ray();
+
+		//creates a ray starting at 'origin' along 'direction' up to 'length' directions away
+		constexpr ray(const vec3& origin, const vec3& direction, float length = std::numeric_limits<float>::infinity());
+
+		vec3 origin;
+		vec3 direction;
+		float length;
+	};
+
+	//returns the ray covering the segment from 'a' to 'b' (distances 0 to 1)
+	constexpr ray segment(const vec3& a, const vec3& b);
+
+	//the closest hit of a ray
+	struct ray_hit
+	{
+		static const std::uint32_t none = 0xFFFFFFFF;
+
+		float t;             //distance along the ray
+		float u, v;          //barycentric coordinates of the hit in the triangle (point = a + u * (b - a) + v * (c - a)); 0 for boxes
+		std::uint32_t index; //primitive hit, or none
+	};
+
+	//returns whether 'r' hits the triangle 'a', 'b', 'c' (from either side), writing the distance and the
+	//barycentric coordinates of the hit to 't', 'u', and 'v'
+	bool intersect(const ray& r, const vec3& a, const vec3& b, const vec3& c, float& t, float& u, float& v);
+
+	//returns whether 'r' hits 'box', writing the distance where it enters (0 when it starts inside) to 't'
+	bool intersect(const ray& r, const aabb& box, float& t);
+
+	//BOUNDING VOLUME HIERARCHY
+
+	//node of a bvh, 32 bytes: the two children of an inner node are stored next to each other, so both
+	//boxes are tested from one cache line
+	struct bvh_node
+	{
+		vec3 min;
+		std::uint32_t first; //the first child of an inner node (the second is first + 1), or the first primitive of a leaf in primitives()
+		vec3 max;
+		std::uint32_t count; //the number of primitives of a leaf, 0 for inner nodes
+	};
+
+	//tree of boxes over triangles or boxes for ray and overlap queries, built with the surface area
+	//heuristic over binned centroids and flattened into one array of nodes (node 0 is the root)
+	//the primitives are copied in leaf order, so the bvh doesn't refer to the input after build()
+	//the queries are const and may run on several threads at once
+	struct bvh
+	{
+		//the deepest level of a leaf below the root
+		static const unsigned max_depth = 64;
+
+		//creates an empty bvh, which no ray hits
+		bvh();
+
+		//builds the bvh over the 'n' boxes 'boxes'; the rays hit the boxes themselves
+		//the subtrees are built on up to 'threads' threads (0 means one per hardware thread)
+		void build(const aabb* boxes, std::size_t n, unsigned threads = 1);
+
+		//builds the bvh over 'n' triangles with the vertices vertices[indices[3 * i]], vertices[indices[3 * i + 1]],
+		//and vertices[indices[3 * i + 2]], or vertices[3 * i], ... when 'indices' is null
+		void build(const vec3* vertices, const std::uint32_t* indices, std::size_t n, unsigned threads = 1);
+
+		//returns whether 'r' hits a primitive, writing the closest hit to 'hit'
+		bool intersect(const ray& r, ray_hit& hit) const;
+
+		//returns whether 'r' hits any primitive, stopping at the first one found (e.g. for line of sight)
+		bool occluded(const ray& r) const;
+
+		//writes the closest hit of each of the 'n' rays 'rays' to 'hits' (index ray_hit::none for misses)
+		//the rays traverse the tree in packets of simd width, which pays off when they are coherent
+		void intersect(const ray* rays, ray_hit* hits, std::size_t n) const;
+
+		//sets bit i % 32 of mask[i / 32] for every ray i of the 'n' rays 'rays' that hits a primitive, and clears
+		//the others; 'mask' must hold (n + 31) / 32 words
+		void occluded(const ray* rays, std::uint32_t* mask, std::size_t n) const;
+
+		//appends the indices of the primitives whose boxes overlap 'box' to 'out'
+		void overlap(const aabb& box, std::vector<std::uint32_t>& out) const;
+
+		//returns the box around every primitive
+		aabb bounds() const { return tree.empty() ? aabb() : aabb(tree[0].min, tree[0].max); }
+
+		//returns the number of primitives
+		std::size_t size() const { return order.size(); }
+
+		//returns the flattened tree
+		const std::vector<bvh_node>& nodes() const { return tree; }
+
+		//returns the indices of the input primitives in leaf order
+		const std::vector<std::uint32_t>& primitives() const { return order; }
+
+		//returns the vertices of the triangles in leaf order, three per primitive (empty for boxes)
+		const std::vector<vec3>& triangles() const { return leaf_triangles; }
+
+		//returns the boxes in leaf order (empty for triangles)
+		const std::vector<aabb>& boxes() const { return leaf_boxes; }
+
+	private:
+		//builds the tree over the primitive boxes 'prims', filling 'tree' and 'order'
+		void build_tree(const std::vector<aabb>& prims, unsigned threads);
+
+		std::vector<bvh_node> tree;
+		std::vector<std::uint32_t> order;
+		std::vector<vec3> leaf_triangles;
+		std::vector<aabb> leaf_boxes;
+	};
+
+    //INLINE CONSTRUCTORS
+
+    //RAY
+
+    constexpr ray::ray() : origin(0), direction(0), length(0) {}
+
+    constexpr ray::ray(const vec3& origin, const vec3& direction, float length) : origin(origin), direction(direction), length(length) {}
+
+    //CONSTEXPR FUNCTIONS
+
+    constexpr ray segment(const vec3& a, const vec3& b)
+    {
+        return ray(a, b - a, 1);
+    }
+}
+
+#endif
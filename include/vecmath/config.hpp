@@ -0,0 +1,42 @@
+#ifndef VECMATH_CONFIG_H
+#define VECMATH_CONFIG_H
+
+//when VECMATH_HEADER_ONLY is defined, every function is defined inline in the headers
+//(see vector.inl, matrix.inl, and affine.inl) so calls in hot loops can be inlined without LTO
+//the vecmath library then only holds the array functions (batch.hpp, soa.hpp)
+//constexpr functions and the constants (vec3::up, PI, etc.) are always defined in the headers
+
+#ifdef VECMATH_HEADER_ONLY
+	#define VECMATH_INLINE inline
+#else
+	#define VECMATH_INLINE
+#endif
+
+//VECMATH_CONSTANT_EVALUATED() is true while a constexpr function runs in a constant expression, so it
+//can avoid what constant evaluation rejects (indexing a union, simd intrinsics, libm) and keep those at run time
+//without compiler support (gcc 9, clang 9, msvc 19.25) it is always false, and constexpr functions that
+//index components or take a square root can only be called at run time
+
+#if defined(__clang__)
+	#if __has_builtin(__builtin_is_constant_evaluated)
+		#define VECMATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+	#endif
+#elif defined(__GNUC__) && __GNUC__ >= 9 || defined(_MSC_VER) && _MSC_VER >= 1925
+	#define VECMATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#ifndef VECMATH_CONSTANT_EVALUATED
+	#define VECMATH_CONSTANT_EVALUATED() false
+#endif
+
+//VECMATH_LAYOUT(type, floats) checks that 'type' is 'floats' tightly packed floats without user defined
+//copies, so arrays of it can be copied with memcpy (copy() in batch.hpp), grown by std::vector with a
+//memmove, and written to gpu or network buffers as they are
+
+#include <type_traits>
+
+#define VECMATH_LAYOUT(type, floats) \
+	static_assert(std::is_trivially_copyable<type>::value && std::is_standard_layout<type>::value, #type " must be trivially copyable and standard layout"); \
+	static_assert(sizeof(type) == (floats) * sizeof(float) && alignof(type) == alignof(float), #type " must be " #floats " tightly packed floats")
+
+#endif
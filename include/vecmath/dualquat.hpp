@@ -0,0 +1,156 @@
+#ifndef VECMATH_DUALQUAT_H
+#define VECMATH_DUALQUAT_H
+
+#include "affine.hpp"
+
+namespace vcm
+{
+	//dual quaternion: a rigid transform (translation * rotation) as real + e * dual, where 'real' is the
+	//rotation and 'dual' is 0.5 * translation * rotation
+	//unlike matrices, dual quaternions can be blended linearly and normalized without shrinking the
+	//result, which is what dual quaternion skinning (skinning.hpp) relies on; they hold no scale
+	struct dualquat
+	{
+		//creates an identity transform
+		constexpr dualquat();
+
+		//creates a dual quaternion from its parts
+		constexpr dualquat(const quat& real, const quat& dual);
+
+		//creates the transform translation * rotation from 'tran' and 'rot', like compose(tran, rot)
+		//'rot' must be normalized
+		constexpr dualquat(const vec3& tran, const quat& rot);
+
+		//creates a dual quaternion from an existing dual quaternion
+		constexpr dualquat(const dualquat& other) = default;
+
+		//creates the rigid part of 'm', which must be a translation * rotation (* uniform scale) transform;
+		//the scale is dropped
+		explicit dualquat(const mat4& m);
+
+		//creates the rigid part of 'a', as dualquat(const mat4&)
+		explicit dualquat(const affine3& a);
+
+		constexpr bool operator==(const dualquat& other) const { return real == other.real && dual == other.dual; }
+		constexpr bool operator!=(const dualquat& other) const { return real != other.real || dual != other.dual; }
+
+		constexpr dualquat operator+(const dualquat& other) const { return dualquat(real + other.real, dual + other.dual); }
+		constexpr dualquat operator-(const dualquat& other) const { return dualquat(real - other.real, dual - other.dual); }
+		constexpr dualquat operator*(float scalar) const { return dualquat(real * scalar, dual * scalar); }
+
+		//returns the transform that applies 'other' first and then this transform
+		constexpr dualquat operator*(const dualquat& other) const { return dualquat(real * other.real, real * other.dual + dual * other.real); }
+
+		constexpr dualquat& operator=(const dualquat& other) = default;
+
+		constexpr dualquat& operator+=(const dualquat& other)
+		{
+			return (*this = (*this + other));
+		}
+
+		constexpr dualquat& operator*=(float scalar)
+		{
+			return (*this = (*this * scalar));
+		}
+
+		constexpr dualquat& operator*=(const dualquat& other)
+		{
+			return (*this = (*this * other));
+		}
+
+		quat real; //rotation
+		quat dual; //0.5 * translation * rotation
+	};
+
+	//returns the rotation of 'dq'
+	constexpr quat rotation(const dualquat& dq);
+
+	//returns the translation of 'dq', which must be normalized
+	constexpr vec3 translation(const dualquat& dq);
+
+	//returns 'dq' scaled to a unit rotation, e.g. after blending
+	//a zero dual quaternion is returned as it is
+	constexpr dualquat normalize(const dualquat& dq);
+
+	//returns the inverse of 'dq', which must be normalized
+	constexpr dualquat inverse(const dualquat& dq);
+
+	//returns the point 'p' transformed by 'dq', which must be normalized
+	constexpr vec3 transform_point(const dualquat& dq, const vec3& p);
+
+	//returns the direction vector 'v' rotated by 'dq', which must be normalized
+	constexpr vec3 transform_vector(const dualquat& dq, const vec3& v);
+
+	//creates a transform matrix (translation * rotation) from 'dq', which must be normalized
+	constexpr mat4 compose(const dualquat& dq);
+
+	//creates an affine transform (translation * rotation) from 'dq', which must be normalized
+	affine3 compose_affine(const dualquat& dq);
+
+	//LAYOUT
+
+	VECMATH_LAYOUT(dualquat, 8);
+
+    //INLINE CONSTRUCTORS
+
+    //DUALQUAT
+
+    constexpr dualquat::dualquat() : real(0, 0, 0, 1), dual(0, 0, 0, 0) {}
+
+    constexpr dualquat::dualquat(const quat& real, const quat& dual) : real(real), dual(dual) {}
+
+    constexpr dualquat::dualquat(const vec3& tran, const quat& rot) : real(rot), dual(quat(tran, 0) * rot * 0.5f) {}
+
+
+    //CONSTEXPR FUNCTIONS
+
+    constexpr quat rotation(const dualquat& dq)
+    {
+        return dq.real;
+    }
+
+    constexpr vec3 translation(const dualquat& dq)
+    {
+        //the vector part of 2 * dual * inverse(real)
+        vec3 r(dq.real.x, dq.real.y, dq.real.z);
+        vec3 d(dq.dual.x, dq.dual.y, dq.dual.z);
+
+        return (d * dq.real.w - r * dq.dual.w + cross(r, d)) * 2;
+    }
+
+    constexpr dualquat normalize(const dualquat& dq)
+    {
+        float len = length(dq.real);
+        if (len == 0)
+            return dq;
+
+        return dq * (1.0f / len);
+    }
+
+    constexpr dualquat inverse(const dualquat& dq)
+    {
+        //the conjugate of both parts
+        return dualquat(inverse(dq.real), inverse(dq.dual));
+    }
+
+    constexpr vec3 transform_point(const dualquat& dq, const vec3& p)
+    {
+        return transform_vector(dq, p) + translation(dq);
+    }
+
+    constexpr vec3 transform_vector(const dualquat& dq, const vec3& v)
+    {
+        return rotate(dq.real, v);
+    }
+
+    constexpr mat4 compose(const dualquat& dq)
+    {
+        return compose(translation(dq), dq.real);
+    }
+}
+
+#ifdef VECMATH_HEADER_ONLY
+#include "dualquat.inl"
+#endif
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef VECMATH_DUALQUAT_INL
+#define VECMATH_DUALQUAT_INL
+
+//definitions of the functions declared in dualquat.hpp
+//included by dualquat.hpp when VECMATH_HEADER_ONLY is defined, otherwise compiled into src/dualquat.cpp
+
+#include "dualquat.hpp"
+
+namespace vcm
+{
+	VECMATH_INLINE dualquat::dualquat(const mat4& m) 
+	{
+		*this = dualquat(affine3(m));
+	}
+
+	VECMATH_INLINE dualquat::dualquat(const affine3& a) 
+	{
+		//quat(const mat3&) expects unit columns, so a uniform scale is divided out first
+		float scale = length(a.m[0]);
+		float inv = scale == 0 ? 1.0f : 1.0f / scale;
+
+		*this = dualquat(a.m[3], normalize(quat(mat3(a.m[0] * inv, a.m[1] * inv, a.m[2] * inv))));
+	}
+
+	VECMATH_INLINE affine3 compose_affine(const dualquat& dq) 
+	{
+		return compose_affine(translation(dq), dq.real);
+	}
+}
+
+#endif
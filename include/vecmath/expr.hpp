@@ -0,0 +1,254 @@
+#ifndef VECMATH_EXPR_H
+#define VECMATH_EXPR_H
+
+#include "soa.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vcm
+{
+	//LAZY ARRAY EXPRESSIONS
+	//opt-in expression templates: arithmetic on arrays wrapped by lazy() builds an expression tree instead
+	//of computing anything, and assign() evaluates the whole tree in a single loop, element by element,
+	//with the operators and functions of the element types, so
+	//
+	//    assign(out, n, lazy(a) + (lazy(b) - lazy(a)) * lazy(t));
+	//
+	//writes a[i] + (b[i] - a[i]) * t[i] for every i without any temporary arrays
+	//operands that aren't expressions (a vec3, a float, a mat4, ...) are used for every element
+	//with optimization enabled (-O3, /O2) the compiler vectorizes the loop, best when the streams are soa
+
+	namespace expr
+	{
+		//base of every expression; an expression has 'operator[](std::size_t i) const' returning element i
+		struct node {};
+
+		template <typename T>
+		inline constexpr bool is_node = std::is_base_of<node, T>::value;
+
+		template <typename... T>
+		inline constexpr bool any_node = (is_node<T> || ...);
+
+		//the elements of an array
+		template <typename T>
+		struct array : node
+		{
+			T operator[](std::size_t i) const { return p[i]; }
+
+			const T* p;
+		};
+
+		//the elements of a vec3_soa
+		struct vec3_stream : node
+		{
+			vec3 operator[](std::size_t i) const { return vec3(x[i], y[i], z[i]); }
+
+			const float* x;
+			const float* y;
+			const float* z;
+		};
+
+		//the elements of a quat_soa
+		struct quat_stream : node
+		{
+			quat operator[](std::size_t i) const { return quat(x[i], y[i], z[i], w[i]); }
+
+			const float* x;
+			const float* y;
+			const float* z;
+			const float* w;
+		};
+
+		//a value used for every element
+		template <typename T>
+		struct constant : node
+		{
+			T operator[](std::size_t) const { return v; }
+
+			T v;
+		};
+
+		//'f' applied to the elements of the expressions 'e'
+		template <typename F, typename... E>
+		struct apply : node
+		{
+			auto operator[](std::size_t i) const { return call(i, std::index_sequence_for<E...>()); }
+
+			template <std::size_t... I>
+			auto call(std::size_t i, std::index_sequence<I...>) const { return f(std::get<I>(e)[i]...); }
+
+			F f;
+			std::tuple<E...> e;
+		};
+
+		//returns 'v' if it is an expression, otherwise a constant of it
+		template <typename T>
+		auto wrap(const T& v)
+		{
+			if constexpr (is_node<T>)
+				return v;
+			else
+				return constant<T>{ {}, v };
+		}
+
+		template <typename F, typename... A>
+		auto make(F f, const A&... a)
+		{
+			return apply<F, decltype(wrap(a))...>{ {}, f, std::make_tuple(wrap(a)...) };
+		}
+
+		//OPERATORS
+		//found through the expression types, so they don't affect vec3 + vec3 and the like
+
+		template <typename A, typename B, typename = std::enable_if_t<any_node<A, B>>>
+		auto operator+(const A& a, const B& b) { return make([](const auto& x, const auto& y) { return x + y; }, a, b); }
+
+		template <typename A, typename B, typename = std::enable_if_t<any_node<A, B>>>
+		auto operator-(const A& a, const B& b) { return make([](const auto& x, const auto& y) { return x - y; }, a, b); }
+
+		template <typename A, typename B, typename = std::enable_if_t<any_node<A, B>>>
+		auto operator*(const A& a, const B& b) { return make([](const auto& x, const auto& y) { return x * y; }, a, b); }
+
+		template <typename A, typename B, typename = std::enable_if_t<any_node<A, B>>>
+		auto operator/(const A& a, const B& b) { return make([](const auto& x, const auto& y) { return x / y; }, a, b); }
+
+		template <typename A, typename = std::enable_if_t<is_node<A>>>
+		auto operator-(const A& a) { return make([](const auto& x) { return -x; }, a); }
+
+		//FUNCTIONS
+		//the functions of vector.hpp, element by element
+
+		template <typename A, typename B, typename = std::enable_if_t<any_node<A, B>>>
+		auto dot(const A& a, const B& b) { return make([](const auto& x, const auto& y) { return vcm::dot(x, y); }, a, b); }
+
+		template <typename A, typename B, typename = std::enable_if_t<any_node<A, B>>>
+		auto cross(const A& a, const B& b) { return make([](const auto& x, const auto& y) { return vcm::cross(x, y); }, a, b); }
+
+		template <typename A, typename B, typename = std::enable_if_t<any_node<A, B>>>
+		auto min(const A& a, const B& b) { return make([](const auto& x, const auto& y) { return vcm::min(x, y); }, a, b); }
+
+		template <typename A, typename B, typename = std::enable_if_t<any_node<A, B>>>
+		auto max(const A& a, const B& b) { return make([](const auto& x, const auto& y) { return vcm::max(x, y); }, a, b); }
+
+		template <typename A, typename B, typename T, typename = std::enable_if_t<any_node<A, B, T>>>
+		auto lerp(const A& a, const B& b, const T& t) { return make([](const auto& x, const auto& y, const auto& s) { return vcm::lerp(x, y, s); }, a, b, t); }
+
+		template <typename A, typename = std::enable_if_t<is_node<A>>>
+		auto length(const A& a) { return make([](const auto& x) { return vcm::length(x); }, a); }
+
+		template <typename A, typename = std::enable_if_t<is_node<A>>>
+		auto length_squared(const A& a) { return make([](const auto& x) { return vcm::length_squared(x); }, a); }
+
+		template <typename A, typename = std::enable_if_t<is_node<A>>>
+		auto normalize(const A& a) { return make([](const auto& x) { return vcm::normalize(x); }, a); }
+	}
+
+	//returns the array 'p' as an expression; it must hold as many elements as are assigned
+	template <typename T>
+	expr::array<T> lazy(const T* p)
+	{
+		return { {}, p };
+	}
+
+	template <typename T>
+	expr::array<T> lazy(const std::vector<T>& v)
+	{
+		return { {}, v.data() };
+	}
+
+	inline expr::vec3_stream lazy(const vec3_soa& s)
+	{
+		return { {}, s.x, s.y, s.z };
+	}
+
+	inline expr::quat_stream lazy(const quat_soa& s)
+	{
+		return { {}, s.x, s.y, s.z, s.w };
+	}
+
+	//returns an expression of 'f' called with the elements of 'e', for operations without an overload above
+	template <typename F, typename... E>
+	auto lazy_map(F f, const E&... e)
+	{
+		return expr::make(f, e...);
+	}
+
+	//EVALUATION
+	//'out' may be one of the arrays read by 'e': element i of the result only depends on element i of the operands
+
+	//writes elements 0 to n - 1 of 'e' to 'out'
+	template <typename T, typename E>
+	void assign(T* out, std::size_t n, const E& e)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = e[i];
+	}
+
+	template <typename T, typename E>
+	void assign(std::vector<T>& out, const E& e)
+	{
+		assign(out.data(), out.size(), e);
+	}
+
+	//writes elements 0 to out.size() - 1 of 'e' to the stream 'out'
+	//each block of elements is evaluated into arrays on the stack and then copied, so the compiler can
+	//vectorize the evaluation without checking whether the component arrays overlap the operands
+	template <typename E>
+	void assign(vec3_soa& out, const E& e)
+	{
+		const std::size_t block = 64;
+
+		for (std::size_t i = 0, n = out.size(); i < n; i += block)
+		{
+			std::size_t k = n - i < block ? n - i : block;
+			float x[block], y[block], z[block];
+
+			for (std::size_t j = 0; j < k; ++j)
+			{
+				vec3 v = e[i + j];
+
+				x[j] = v.x;
+				y[j] = v.y;
+				z[j] = v.z;
+			}
+
+			std::memcpy(out.x + i, x, k * sizeof(float));
+			std::memcpy(out.y + i, y, k * sizeof(float));
+			std::memcpy(out.z + i, z, k * sizeof(float));
+		}
+	}
+
+	template <typename E>
+	void assign(quat_soa& out, const E& e)
+	{
+		const std::size_t block = 64;
+
+		for (std::size_t i = 0, n = out.size(); i < n; i += block)
+		{
+			std::size_t k = n - i < block ? n - i : block;
+			float x[block], y[block], z[block], w[block];
+
+			for (std::size_t j = 0; j < k; ++j)
+			{
+				quat q = e[i + j];
+
+				x[j] = q.x;
+				y[j] = q.y;
+				z[j] = q.z;
+				w[j] = q.w;
+			}
+
+			std::memcpy(out.x + i, x, k * sizeof(float));
+			std::memcpy(out.y + i, y, k * sizeof(float));
+			std::memcpy(out.z + i, z, k * sizeof(float));
+			std::memcpy(out.w + i, w, k * sizeof(float));
+		}
+	}
+}
+
+#endif
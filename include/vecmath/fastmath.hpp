@@ -0,0 +1,176 @@
+#ifndef VECMATH_FASTMATH_H
+#define VECMATH_FASTMATH_H
+
+#include "matrix.hpp"
+#include "soa.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+namespace vcm
+{
+	//FAST MATH
+	//opt-in approximations of the square roots and libm calls behind normalize(), angle_axis(), euler(),
+	//from_angle(), and perspective(); the errors are measured in ulps against double precision
+	//the regular functions are unchanged, use these where the error is acceptable
+	//the single value functions are short enough that a call costs as much as they save, so they pay off
+	//inlined (VECMATH_HEADER_ONLY); the array functions pay off either way
+
+	//returns 1 / sqrt(x) for x > 0, within 4 ulp: the sse reciprocal square root estimate refined by one
+	//newton step (with VECMATH_SSE, otherwise 1 / std::sqrt(x)); the estimate, and so the last bit of the
+	//result, may differ between cpu vendors
+	float rsqrt_fast(float x);
+
+	//returns 'v' normalized with rsqrt_fast(), each component within 6 ulp (normalize() is within 3)
+	//zero vectors are returned unchanged, like normalize()
+	vec2 normalize_fast(const vec2& v);
+	vec3 normalize_fast(const vec3& v);
+	vec4 normalize_fast(const vec4& v);
+	quat normalize_fast(const quat& q);
+
+	//writes sin(x) and cos(x) to 's' and 'c' for |x| <= 8192, within 2 ulp (1e-7 absolute near the zeros)
+	//the argument is reduced to [-pi / 4, pi / 4] and both come from the same reduction
+	void sincos_fast(float x, float& s, float& c);
+
+	//returns sin(x), cos(x), or tan(x), as sincos_fast()
+	float sin_fast(float x);
+	float cos_fast(float x);
+	float tan_fast(float x);
+
+	//returns acos(x) for x in [-1, 1], within 3 ulp (5e-7 absolute)
+	float acos_fast(float x);
+
+	//returns atan2(y, x) for finite 'x' and 'y', within 4 ulp (3e-7 absolute); the signed zeros
+	//are handled like std::atan2, and atan2_fast(0, 0) is 0
+	float atan2_fast(float y, float x);
+
+	//writes sincos_fast(x[i]) for each of the 'n' angles to 's' and 'c', across simd lanes
+	void sincos_fast(const float* x, float* s, float* c, std::size_t n);
+
+	//writes the vectors in 'v', normalized with the simd reciprocal square root and one newton step, to 'out'
+	//(resized to match 'v'); the results are within 6 ulp, like normalize_fast(), and differ between backends in the last bits
+	void normalize_fast(const vec3_soa& v, vec3_soa& out);
+
+	//MATH POLICIES
+	//the tier as a type, so code written against a policy switches between the precise and fast functions
+	//without changes: 'precise_math' and 'fast_math' have the same static functions, and 'default_math' is
+	//fast_math when VECMATH_FAST_MATH is defined, precise_math otherwise
+	//
+	//    template <typename Math = default_math>
+	//    vec3 facing(float yaw) { float s, c; Math::sincos(yaw, s, c); return vec3(s, 0, -c); }
+
+	//the regular functions (std::sqrt and libm)
+	struct precise_math
+	{
+		static float rsqrt(float x) { return 1.0f / std::sqrt(x); }
+
+		template <typename T>
+		static T normalize(const T& v) { return vcm::normalize(v); }
+
+		static void sincos(float x, float& s, float& c) { s = std::sin(x); c = std::cos(x); }
+		static float tan(float x) { return std::tan(x); }
+		static float acos(float x) { return std::acos(x); }
+		static float atan2(float y, float x) { return std::atan2(y, x); }
+	};
+
+	//the approximations above
+	struct fast_math
+	{
+		static float rsqrt(float x) { return rsqrt_fast(x); }
+
+		template <typename T>
+		static T normalize(const T& v) { return normalize_fast(v); }
+
+		static void sincos(float x, float& s, float& c) { sincos_fast(x, s, c); }
+		static float tan(float x) { return tan_fast(x); }
+		static float acos(float x) { return acos_fast(x); }
+		static float atan2(float y, float x) { return atan2_fast(y, x); }
+	};
+
+#ifdef VECMATH_FAST_MATH
+	using default_math = fast_math;
+#else
+	using default_math = precise_math;
+#endif
+
+	//the constructors of vector.hpp and matrix.hpp with the functions of 'Math', e.g. angle_axis<fast_math>(a, axis)
+	//angle_axis<precise_math>() and the others evaluate the same expressions as the regular functions (the
+	//results only differ when the compiler fuses multiply-adds differently, e.g. with -mfma)
+
+	//returns a quaternion from an 'angle' (in radians) about an 'axis'
+	template <typename Math>
+	quat angle_axis(float angle, const vec3& axis);
+
+	//returns a quaternion from euler angles
+	template <typename Math>
+	quat euler(const vec3& e);
+
+	//creates a rotation matrix from an 'angle' in radians
+	template <typename Math>
+	mat2 from_angle(float angle);
+
+	//creates a perspective projection matrix, like perspective()
+	template <typename Math>
+	mat4 perspective(float fov, float aspect, float znear, float zfar);
+
+    //TEMPLATE FUNCTIONS
+
+    template <typename Math>
+    quat angle_axis(float angle, const vec3& axis)
+    {
+        float s, c;
+        Math::sincos(angle * 0.5f, s, c);
+
+        return Math::normalize(quat(axis * s, c));
+    }
+
+    template <typename Math>
+    quat euler(const vec3& e)
+    {
+        float s1, c1, s2, c2, s3, c3;
+        Math::sincos(e.y * 0.5f, s1, c1);
+        Math::sincos(e.z * 0.5f, s2, c2);
+        Math::sincos(e.x * 0.5f, s3, c3);
+
+        quat result =
+        {
+            s1 * s2 * c3 + c1 * c2 * s3,
+            s1 * c2 * c3 + c1 * s2 * s3,
+            c1 * s2 * c3 - s1 * c2 * s3,
+            c1 * c2 * c3 - s1 * s2 * s3
+        };
+
+        return Math::normalize(result);
+    }
+
+    template <typename Math>
+    mat2 from_angle(float angle)
+    {
+        float s, c;
+        Math::sincos(angle, s, c);
+
+        return mat2(vec2(c, s), vec2(-s, c));
+    }
+
+    template <typename Math>
+    mat4 perspective(float fov, float aspect, float znear, float zfar)
+    {
+        mat4 result;
+        float f = Math::tan(fov * 0.5f);
+
+        result.m[0][0] = 1.0f / (aspect * f);
+        result.m[1][1] = 1.0f / f;
+        result.m[2][2] = -(zfar + znear) / (zfar - znear);
+        result.m[2][3] = -1;
+        result.m[3][2] = -(2 * zfar * znear) / (zfar - znear);
+        result.m[3][3] = 0;
+
+        return result;
+    }
+}
+
+#ifdef VECMATH_HEADER_ONLY
+#include "fastmath.inl"
+#endif
+
+#endif
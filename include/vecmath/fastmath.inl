@@ -0,0 +1,152 @@
+#ifndef VECMATH_FASTMATH_INL
+#define VECMATH_FASTMATH_INL
+
+//definitions of the functions declared in fastmath.hpp
+//included by fastmath.hpp when VECMATH_HEADER_ONLY is defined, otherwise compiled into src/fastmath.cpp
+//the polynomials match the lane versions in src/vmath.hpp, so the array functions give the same results
+
+#include "fastmath.hpp"
+#include "simd.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace vcm
+{
+	VECMATH_INLINE float rsqrt_fast(float x)
+	{
+#if defined(VECMATH_USE_SSE)
+		//the 12 bit estimate refined by one newton step, in the order that rounds best
+		float r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+		return 0.5f * r * (3.0f - x * r * r);
+#else
+		return 1.0f / std::sqrt(x);
+#endif
+	}
+
+	VECMATH_INLINE vec2 normalize_fast(const vec2& v)
+	{
+		float len2 = length_squared(v);
+		return len2 == 0 ? v : v * rsqrt_fast(len2);
+	}
+
+	VECMATH_INLINE vec3 normalize_fast(const vec3& v)
+	{
+		float len2 = length_squared(v);
+		return len2 == 0 ? v : v * rsqrt_fast(len2);
+	}
+
+	VECMATH_INLINE vec4 normalize_fast(const vec4& v)
+	{
+		float len2 = length_squared(v);
+		return len2 == 0 ? v : v * rsqrt_fast(len2);
+	}
+
+	VECMATH_INLINE quat normalize_fast(const quat& q)
+	{
+		float len2 = length_squared(q);
+		return len2 == 0 ? q : q * rsqrt_fast(len2);
+	}
+
+	VECMATH_INLINE void sincos_fast(float x, float& s, float& c)
+	{
+		//x = k * pi / 2 + r with |r| <= pi / 4; pi / 2 is split in three parts (cody & waite) so that
+		//k times the first part is exact, adding 1.5 * 2^23 rounds to the nearest integer
+		float k = (x * 0.63661977236f + 12582912.0f) - 12582912.0f;
+		float r = ((x - k * 1.5703125f) - k * 4.837512969970703125e-4f) - k * 7.54978995489188216e-8f;
+		float z = r * r;
+
+		//minimax polynomials on [-pi / 4, pi / 4] (cephes sinf and cosf)
+		float sr = r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+		float cr = 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+
+		//the quadrant rotates the pair: (sin, cos), (cos, -sin), (-sin, -cos), (-cos, sin)
+		//applied to the bits, since the quadrants of unrelated angles are unpredictable and branches mispredict
+		std::uint32_t q = (std::uint32_t)(int)k;
+		std::uint32_t swap = 0u - (q & 1);
+
+		std::uint32_t bs, bc;
+		std::memcpy(&bs, &sr, sizeof(bs));
+		std::memcpy(&bc, &cr, sizeof(bc));
+
+		std::uint32_t rs = ((bs & ~swap) | (bc & swap)) ^ ((q & 2) << 30);
+		std::uint32_t rc = ((bc & ~swap) | (bs & swap)) ^ (((q + 1) & 2) << 30);
+
+		std::memcpy(&s, &rs, sizeof(s));
+		std::memcpy(&c, &rc, sizeof(c));
+	}
+
+	VECMATH_INLINE float sin_fast(float x)
+	{
+		float s, c;
+		sincos_fast(x, s, c);
+
+		return s;
+	}
+
+	VECMATH_INLINE float cos_fast(float x)
+	{
+		float s, c;
+		sincos_fast(x, s, c);
+
+		return c;
+	}
+
+	VECMATH_INLINE float tan_fast(float x)
+	{
+		float s, c;
+		sincos_fast(x, s, c);
+
+		return s / c;
+	}
+
+	VECMATH_INLINE float acos_fast(float x)
+	{
+		//abramowitz & stegun 4.4.46 on [0, 1], mirrored with acos(-x) = pi - acos(x)
+		float a = std::fabs(x);
+
+		float p = -0.0012624911f;
+		p = p * a + 0.0066700901f;
+		p = p * a - 0.0170881256f;
+		p = p * a + 0.0308918810f;
+		p = p * a - 0.0501743046f;
+		p = p * a + 0.0889789874f;
+		p = p * a - 0.2145988016f;
+		p = p * a + 1.5707963050f;
+
+		float r = std::sqrt(a < 1 ? 1 - a : 0) * p;
+		return x < 0 ? 3.14159265359f - r : r;
+	}
+
+	VECMATH_INLINE float atan2_fast(float y, float x)
+	{
+		//atan of the ratio in [0, 1], moved to [-tan(pi / 8), tan(pi / 8)] around pi / 4 when above
+		//tan(pi / 8), then unfolded into the octant of (x, y)
+		float ax = std::fabs(x), ay = std::fabs(y);
+		float lo = ax < ay ? ax : ay, hi = ax < ay ? ay : ax;
+
+		float t = hi == 0 ? 0 : lo / hi;
+		float base = 0;
+
+		if (t > 0.41421356237f)
+		{
+			t = (t - 1) / (t + 1);
+			base = 0.78539816340f;
+		}
+
+		//minimax polynomial for atan on [-tan(pi / 8), tan(pi / 8)] (cephes atanf)
+		float z = t * t;
+		float r = base + ((((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t);
+
+		if (ay > ax)
+			r = 1.57079632679f - r;
+
+		if (std::signbit(x))
+			r = 3.14159265359f - r;
+
+		return std::signbit(y) ? -r : r;
+	}
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef VECMATH_FRUSTUM_H
+#define VECMATH_FRUSTUM_H
+
+#include "matrix.hpp"
+#include "soa.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vcm
+{
+	//view frustum as six planes facing inward; the point 'p' is on the inner side of
+	//the plane 'pl' when dot(vec3(pl), p) + pl.w >= 0
+	struct frustum
+	{
+		//creates a frustum that contains everything
+		frustum();
+
+		//extracts the planes of the view-projection matrix 'view_proj' (gribb & hartmann), with the
+		//-w <= x, y, z <= w clip volume of perspective() and orthographic()
+		explicit frustum(const mat4& view_proj);
+
+		vec4 planes[6]; //left, right, bottom, top, near, far; normals have unit length
+	};
+
+	//returns whether the sphere at 'center' with 'radius' is at least partly inside 'f'
+	bool intersects(const frustum& f, const vec3& center, float radius);
+
+	//returns whether the axis aligned box from 'min' to 'max' is at least partly inside 'f'
+	//conservative: a box outside the frustum but not fully outside any single plane
+	//(near an edge or corner) is reported as intersecting
+	bool intersects(const frustum& f, const vec3& min, const vec3& max);
+
+	//BATCH CULLING
+	//tests a whole stream of bounding volumes against 'f', with the results of intersects()
+	//cull_*() sets bit i % 32 of mask[i / 32] for every visible object i, and clears the others;
+	//'mask' must hold (n + 31) / 32 words
+	//cull_*_compact() writes the indices of the visible objects, in order, to 'indices' and
+	//returns how many there are; 'indices' must have room for n indices
+
+	//culls the spheres at 'centers' with the 'radii' (centers.size() floats)
+	void cull_spheres(const frustum& f, const vec3_soa& centers, const float* radii, std::uint32_t* mask);
+	std::size_t cull_spheres_compact(const frustum& f, const vec3_soa& centers, const float* radii, std::uint32_t* indices);
+
+	//culls the axis aligned boxes from 'min' to 'max', which must be the same size
+	void cull_aabbs(const frustum& f, const vec3_soa& min, const vec3_soa& max, std::uint32_t* mask);
+	std::size_t cull_aabbs_compact(const frustum& f, const vec3_soa& min, const vec3_soa& max, std::uint32_t* indices);
+
+    //INLINE CONSTRUCTORS
+
+    //FRUSTUM
+
+    inline frustum::frustum()
+    {
+        for (vec4& p : planes)
+            p = { 0, 0, 0, 1 };
+    }
+}
+
+#ifdef VECMATH_HEADER_ONLY
+#include "frustum.inl"
+#endif
+
+#endif
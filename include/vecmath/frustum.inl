@@ -0,0 +1,64 @@
+#ifndef VECMATH_FRUSTUM_INL
+#define VECMATH_FRUSTUM_INL
+
+//definitions of the functions declared in frustum.hpp, apart from the batch culling functions
+//included by frustum.hpp when VECMATH_HEADER_ONLY is defined, otherwise compiled into src/frustum.cpp
+
+#include "frustum.hpp"
+
+#include <cmath>
+
+namespace vcm
+{
+	VECMATH_INLINE frustum::frustum(const mat4& view_proj) 
+	{
+		//each clip plane is the last row of the matrix plus or minus one of the others
+		vec4 r0 = view_proj.row(0);
+		vec4 r1 = view_proj.row(1);
+		vec4 r2 = view_proj.row(2);
+		vec4 r3 = view_proj.row(3);
+
+		planes[0] = r3 + r0;
+		planes[1] = r3 - r0;
+		planes[2] = r3 + r1;
+		planes[3] = r3 - r1;
+		planes[4] = r3 + r2;
+		planes[5] = r3 - r2;
+
+		for (vec4& p : planes)
+		{
+			float len = length(vec3(p));
+			if (len != 0)
+				p *= 1.0f / len;
+		}
+	}
+
+	VECMATH_INLINE bool intersects(const frustum& f, const vec3& center, float radius) 
+	{
+		for (const vec4& p : f.planes)
+		{
+			if (dot(vec3(p), center) + p.w < -radius)
+				return false;
+		}
+
+		return true;
+	}
+
+	VECMATH_INLINE bool intersects(const frustum& f, const vec3& min, const vec3& max) 
+	{
+		vec3 center = (min + max) * 0.5f;
+		vec3 extent = (max - min) * 0.5f;
+
+		for (const vec4& p : f.planes)
+		{
+			//distance of the box corner furthest along the plane normal
+			float r = std::fabs(p.x) * extent.x + std::fabs(p.y) * extent.y + std::fabs(p.z) * extent.z;
+			if (dot(vec3(p), center) + p.w + r < 0)
+				return false;
+		}
+
+		return true;
+	}
+}
+
+#endif
@@ -12,6 +12,9 @@ namespace vcm
 	struct mat2;
 	struct mat3;
 	struct mat4;
+	struct affine3;
+	struct dualquat;
+	struct aabb;
 }
 
 #endif
@@ -0,0 +1,78 @@
+#ifndef VECMATH_HIERARCHY_H
+#define VECMATH_HIERARCHY_H
+
+#include "matrix.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace vcm
+{
+	class task_pool;
+
+	//tree of transforms stored as arrays, each node referring to its parent by index
+	//update() computes the world matrices (world[parent] * local) one depth level at a time,
+	//splitting each level across a thread pool, and only for nodes whose local transform
+	//or an ancestor's changed since the last update
+	struct transform_hierarchy
+	{
+		static const std::size_t no_parent = (std::size_t)-1;
+
+		//creates an empty hierarchy updated by 'threads' threads (0 means one per hardware thread)
+		explicit transform_hierarchy(unsigned threads = 0);
+		~transform_hierarchy();
+
+		transform_hierarchy(const transform_hierarchy&) = delete;
+		transform_hierarchy& operator=(const transform_hierarchy&) = delete;
+
+		//adds a node with the local transform 'local' under 'parent' and returns its index
+		std::size_t add(const mat4& local, std::size_t parent = no_parent);
+
+		//replaces every node with the 'n' local transforms 'locals' and their parent indices 'parents'
+		//parents may appear after their children, but must not form cycles
+		void assign(const mat4* locals, const std::size_t* parents, std::size_t n);
+
+		//moves node 'i' under 'parent' (or no_parent); returns false, leaving the node where it was, if 'parent'
+		//is 'i' or one of its descendants, which would form a cycle
+		bool set_parent(std::size_t i, std::size_t parent);
+
+		//sets the local transform of node 'i', marking it and its subtree for update
+		void set_local(std::size_t i, const mat4& local);
+
+		const mat4& local(std::size_t i) const { return locals[i]; }
+
+		//returns the world transform of node 'i' as of the last update()
+		const mat4& world(std::size_t i) const { return worlds[i]; }
+
+		//returns the world transforms of every node as of the last update()
+		const mat4* world_data() const { return worlds.data(); }
+
+		std::size_t parent(std::size_t i) const { return parents[i]; }
+		std::size_t size() const { return locals.size(); }
+
+		//recomputes the world transforms of every changed node
+		void update();
+
+	private:
+		//sorts the nodes by depth into 'order' and 'levels'
+		void build_levels();
+
+		std::vector<mat4> locals;
+		std::vector<mat4> worlds;
+		std::vector<std::size_t> parents;
+
+		std::vector<unsigned char> dirty;   //local transform set since the last update
+		std::vector<unsigned char> changed; //world transform recomputed in this update
+
+		std::vector<std::size_t> depths;
+		std::vector<std::size_t> order;  //node indices sorted by depth
+		std::vector<std::size_t> levels; //start of each depth level in 'order', plus the end
+
+		bool structure_changed;
+		bool any_dirty;
+
+		task_pool* pool;
+	};
+}
+
+#endif
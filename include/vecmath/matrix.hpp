@@ -9,71 +9,65 @@ namespace vcm
 	struct mat2 
 	{
 		//creates an identity matrix
-		mat2();
+		constexpr mat2();
 
 		//creates a matrix with every component set to the value of 'all'
-		explicit mat2(float all);
+		explicit constexpr mat2(float all);
 
 		//creates a matrix with column vectors 'a', and 'b'
-		mat2(const vec2& a, const vec2& b);
+		constexpr mat2(const vec2& a, const vec2& b);
 
 		//creates a matrix from an existing matrix
-		mat2(const mat2& other);
+		constexpr mat2(const mat2& other) = default;
 
 		//creates a matrix from an existing matrix
-		explicit mat2(const mat3& other);
+		explicit constexpr mat2(const mat3& other);
 
 		//creates a matrix from an existing matrix
-		explicit mat2(const mat4& other);
+		explicit constexpr mat2(const mat4& other);
 
-		vec2& operator[](unsigned i) { return m[i]; }
-		vec2 operator[](unsigned i) const { return m[i]; }
+		constexpr vec2& operator[](unsigned i) { return m[i]; }
+		constexpr vec2 operator[](unsigned i) const { return m[i]; }
 
 		//returns the row vector at index 'i'
-		vec2 row(unsigned i) const 
+		constexpr vec2 row(unsigned i) const 
 		{
 			return vec2(m[0][i], m[1][i]);
 		}
 
-		bool operator==(const mat2& other) const { return m[0] == other.m[0] && m[1] == other.m[1]; }
-		bool operator!=(const mat2& other) const { return m[0] != other.m[0] || m[1] != other.m[1]; }
+		constexpr bool operator==(const mat2& other) const { return m[0] == other.m[0] && m[1] == other.m[1]; }
+		constexpr bool operator!=(const mat2& other) const { return m[0] != other.m[0] || m[1] != other.m[1]; }
 
-		mat2 operator+(const mat2& other) const { return mat2(m[0] + other.m[0], m[1] + other.m[1]); }
-		mat2 operator-(const mat2& other) const { return mat2(m[0] - other.m[0], m[1] - other.m[1]); }
-		mat2 operator*(const float scalar) const { return mat2(m[0] * scalar, m[1] * scalar); }
+		constexpr mat2 operator+(const mat2& other) const { return mat2(m[0] + other.m[0], m[1] + other.m[1]); }
+		constexpr mat2 operator-(const mat2& other) const { return mat2(m[0] - other.m[0], m[1] - other.m[1]); }
+		constexpr mat2 operator*(const float scalar) const { return mat2(m[0] * scalar, m[1] * scalar); }
 
-		mat2 operator*(const mat2& other) const;
-		vec2 operator*(const vec2& other) const;
+		constexpr mat2 operator*(const mat2& other) const;
+		constexpr vec2 operator*(const vec2& other) const;
 
-		mat2& operator=(const mat2& other) 
-		{
-			m[0] = other.m[0];
-			m[1] = other.m[1];
-
-			return *this;
-		}
+		constexpr mat2& operator=(const mat2& other) = default;
 
-		mat2& operator+=(const mat2& other) 
+		constexpr mat2& operator+=(const mat2& other) 
 		{
 			return (*this = (*this + other));
 		}
 
-		mat2& operator-=(const mat2& other) 
+		constexpr mat2& operator-=(const mat2& other) 
 		{
 			return (*this = (*this - other));
 		}
 
-		mat2& operator*=(const float scalar) 
+		constexpr mat2& operator*=(const float scalar) 
 		{
 			return (*this = (*this * scalar));
 		}
 
-		mat2& operator*=(const mat2& other) 
+		constexpr mat2& operator*=(const mat2& other) 
 		{
 			return (*this = (*this * other));
 		}
 
-		mat2 operator-() const 
+		constexpr mat2 operator-() const 
 		{
 			return mat2(-m[0], -m[1]);
 		}
@@ -82,10 +76,10 @@ namespace vcm
 	};
 
 	//returns 'm' transposed
-	mat2 transpose(const mat2& m);
+	constexpr mat2 transpose(const mat2& m);
 
 	//returns the determinant of 'm'
-	float determinant(const mat2& m);
+	constexpr float determinant(const mat2& m);
 
 	//returns the inverse of 'm'
 	mat2 inverse(const mat2& m);
@@ -97,75 +91,68 @@ namespace vcm
 	struct mat3 
 	{
 		//creates an identity matrix
-		mat3();
+		constexpr mat3();
 
 		//creates a matrix with every component set to the value of 'all'
-		explicit mat3(float all);
+		explicit constexpr mat3(float all);
 
 		//creates a matrix with column vectors 'a', 'b', and 'c'
-		mat3(const vec3& a, const vec3& b, const vec3& c);
+		constexpr mat3(const vec3& a, const vec3& b, const vec3& c);
 
 		//creates a matrix from an existing matrix
-		mat3(const mat3& other);
+		constexpr mat3(const mat3& other) = default;
 
 		//creates a matrix from an existing matrix
-		explicit mat3(const mat2& other);
+		explicit constexpr mat3(const mat2& other);
 
 		//creates a matrix from an existing matrix
-		explicit mat3(const mat4& other);
+		explicit constexpr mat3(const mat4& other);
 
 		//creates a rotation matrix from an existing quaternion
-		explicit mat3(const quat& other);
+		explicit constexpr mat3(const quat& other);
 
-		vec3& operator[](unsigned i) { return m[i]; }
-		vec3 operator[](unsigned i) const { return m[i]; }
+		constexpr vec3& operator[](unsigned i) { return m[i]; }
+		constexpr vec3 operator[](unsigned i) const { return m[i]; }
 
 		//returns the row vector at index 'i'
-		vec3 row(unsigned i) const 
+		constexpr vec3 row(unsigned i) const 
 		{
 			return vec3(m[0][i], m[1][i], m[2][i]);
 		}
 
-		bool operator==(const mat3& other) const { return m[0] == other.m[0] && m[1] == other.m[1] && m[2] == other.m[2]; }
-		bool operator!=(const mat3& other) const { return m[0] != other.m[0] || m[1] != other.m[1] || m[2] != other.m[2]; }
-
-		mat3 operator+(const mat3& other) const { return mat3(m[0] + other.m[0], m[1] + other.m[1], m[2] + other.m[2]); }
-		mat3 operator-(const mat3& other) const { return mat3(m[0] - other.m[0], m[1] - other.m[1], m[2] - other.m[2]); }
-		mat3 operator*(const float scalar) const { return mat3(m[0] * scalar, m[1] * scalar, m[2] * scalar); }
+		constexpr bool operator==(const mat3& other) const { return m[0] == other.m[0] && m[1] == other.m[1] && m[2] == other.m[2]; }
+		constexpr bool operator!=(const mat3& other) const { return m[0] != other.m[0] || m[1] != other.m[1] || m[2] != other.m[2]; }
 
-		mat3 operator*(const mat3& other) const;
-		vec3 operator*(const vec3& other) const;
+		constexpr mat3 operator+(const mat3& other) const { return mat3(m[0] + other.m[0], m[1] + other.m[1], m[2] + other.m[2]); }
+		constexpr mat3 operator-(const mat3& other) const { return mat3(m[0] - other.m[0], m[1] - other.m[1], m[2] - other.m[2]); }
+		constexpr mat3 operator*(const float scalar) const { return mat3(m[0] * scalar, m[1] * scalar, m[2] * scalar); }
 
-		mat3& operator=(const mat3& other) 
-		{
-			m[0] = other.m[0];
-			m[1] = other.m[1];
-			m[2] = other.m[2];
+		constexpr mat3 operator*(const mat3& other) const;
+		constexpr vec3 operator*(const vec3& other) const;
 
-			return *this;
-		}
+		constexpr mat3& operator=(const mat3& other) = default;
 
-		mat3& operator+=(const mat3& other) 
+		constexpr mat3& operator+=(const mat3& other) 
 		{
 			return (*this = (*this + other));
 		}
 
-		mat3& operator-=(const mat3& other) 
+		constexpr mat3& operator-=(const mat3& other) 
 		{
 			return (*this = (*this - other));
 		}
 
-		mat3& operator*=(const float scalar) 
+		constexpr mat3& operator*=(const float scalar) 
 		{
 			return (*this = (*this * scalar));
 		}
 
-		mat3& operator*=(const mat3& other) 
+		constexpr mat3& operator*=(const mat3& other) 
 		{
 			return (*this = (*this * other));
 		}
 
-		mat3 operator-() const 
+		constexpr mat3 operator-() const 
 		{
 			return mat3(-m[0], -m[1], -m[2]);
 		}
@@ -174,10 +161,10 @@ namespace vcm
 	};
 
 	//returns 'm' transposed
-	mat3 transpose(const mat3& m);
+	constexpr mat3 transpose(const mat3& m);
 
 	//returns the determinant of 'm'
-	float determinant(const mat3& m);
+	constexpr float determinant(const mat3& m);
 
 	//returns the inverse of 'm'
 	mat3 inverse(const mat3& m);
@@ -189,73 +176,71 @@ namespace vcm
 	struct mat4 
 	{
 		//creates an identity matrix
-		mat4();
+		constexpr mat4();
 
 		//creates a matrix with every component set to the value of 'all'
-		explicit mat4(float all);
+		explicit constexpr mat4(float all);
 
 		//creates a matrix from column vectors 'a', 'b', 'c', and 'd'
-		mat4(const vec4& a, const vec4& b, const vec4& c, const vec4& d);
+		constexpr mat4(const vec4& a, const vec4& b, const vec4& c, const vec4& d);
 
 		//creates a matrix from an existing matrix
-		mat4(const mat4& other);
+		constexpr mat4(const mat4& other) = default;
 
 		//creates a matrix from an existing matrix
-		explicit mat4(const mat2& other);
+		explicit constexpr mat4(const mat2& other);
 
 		//creates a matrix from an existing matrix
-		explicit mat4(const mat3& other);
+		explicit constexpr mat4(const mat3& other);
 
-		vec4& operator[](unsigned i) { return m[i]; }
-		vec4 operator[](unsigned i) const { return m[i]; }
+		//creates a matrix from an affine transform (defined in affine.hpp)
+		explicit constexpr mat4(const affine3& other);
+
+		constexpr vec4& operator[](unsigned i) { return m[i]; }
+		constexpr vec4 operator[](unsigned i) const { return m[i]; }
 
 		//returns the row vector at index 'i'
-		vec4 row(unsigned i) const 
+		constexpr vec4 row(unsigned i) const 
 		{
 			return vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
 		}
 
-		bool operator==(const mat4& other) const { return m[0] == other.m[0] && m[1] == other.m[1] && m[2] == other.m[2] && m[3] == other.m[3]; }
-		bool operator!=(const mat4& other) const { return m[0] != other.m[0] || m[1] != other.m[1] || m[2] != other.m[2] || m[3] != other.m[3]; }
+		constexpr bool operator==(const mat4& other) const { return m[0] == other.m[0] && m[1] == other.m[1] && m[2] == other.m[2] && m[3] == other.m[3]; }
+		constexpr bool operator!=(const mat4& other) const { return m[0] != other.m[0] || m[1] != other.m[1] || m[2] != other.m[2] || m[3] != other.m[3]; }
 
-		mat4 operator+(const mat4& other) const { return mat4(m[0] + other.m[0], m[1] + other.m[1], m[2] + other.m[2], m[3] + other.m[3]); }
-		mat4 operator-(const mat4& other) const { return mat4(m[0] - other.m[0], m[1] - other.m[1], m[2] - other.m[2], m[3] - other.m[3]); }
-		mat4 operator*(const float scalar) const { return mat4(m[0] * scalar, m[1] * scalar, m[2] * scalar, m[3] * scalar); }
+		constexpr mat4 operator+(const mat4& other) const { return mat4(m[0] + other.m[0], m[1] + other.m[1], m[2] + other.m[2], m[3] + other.m[3]); }
+		constexpr mat4 operator-(const mat4& other) const { return mat4(m[0] - other.m[0], m[1] - other.m[1], m[2] - other.m[2], m[3] - other.m[3]); }
+		constexpr mat4 operator*(const float scalar) const { return mat4(m[0] * scalar, m[1] * scalar, m[2] * scalar, m[3] * scalar); }
 
-		mat4 operator*(const mat4& other) const;
-		vec4 operator*(const vec4& other) const;
+		//with VECMATH_SSE the products are accumulated in the same order as the scalar code, so
+		//results are identical; with VECMATH_AVX each term is a fused multiply-add that rounds once,
+		//so an element may differ from the scalar result by up to 1e-6 * sum(|a[k][i] * b[j][k]|)
+		constexpr mat4 operator*(const mat4& other) const;
+		constexpr vec4 operator*(const vec4& other) const;
 
-		mat4& operator=(const mat4& other) 
-		{
-			m[0] = other.m[0];
-			m[1] = other.m[1];
-			m[2] = other.m[2];
-			m[3] = other.m[3];
+		constexpr mat4& operator=(const mat4& other) = default;
 
-			return *this;
-		}
-
-		mat4& operator+=(const mat4& other) 
+		constexpr mat4& operator+=(const mat4& other) 
 		{
 			return (*this = (*this + other));
 		}
 
-		mat4& operator-=(const mat4& other) 
+		constexpr mat4& operator-=(const mat4& other) 
 		{
 			return (*this = (*this - other));
 		}
 
-		mat4& operator*=(const float scalar) 
+		constexpr mat4& operator*=(const float scalar) 
 		{
 			return (*this = (*this * scalar));
 		}
 
-		mat4& operator*=(const mat4& other) 
+		constexpr mat4& operator*=(const mat4& other) 
 		{
 			return (*this = (*this * other));
 		}
 
-		mat4 operator-() const 
+		constexpr mat4 operator-() const 
 		{
 			return mat4(-m[0], -m[1], -m[2], -m[3]);
 		}
@@ -263,24 +248,55 @@ namespace vcm
 		vec4 m[4]; //columns
 	};
 
+	namespace detail
+	{
+		//the portable products, used in constant expressions and when no simd kernel is available
+		constexpr mat4 product(const mat4& a, const mat4& b);
+		constexpr vec4 product(const mat4& a, const vec4& v);
+
+		//the products at run time, with the kernels selected by simd.hpp (defined in matrix.inl)
+		mat4 multiply(const mat4& a, const mat4& b);
+		vec4 multiply(const mat4& a, const vec4& v);
+	}
+
 	//returns 'm' transposed
-	mat4 transpose(const mat4& m);
+	constexpr mat4 transpose(const mat4& m);
 
 	//returns the determinant of 'm'
-	float determinant(const mat4& m);
+	constexpr float determinant(const mat4& m);
 
 	//returns the inverse of 'm'
 	mat4 inverse(const mat4& m);
 
+	//returns the inverse of 'm', which must be a translation * rotation * scale transform
+	//(such as the result of compose() or look_at()), faster than inverse(m)
+	//shear or projection in 'm' gives a wrong result; use inverse(m) for those
+	mat4 inverse_affine(const mat4& m);
+
+	//scaling of the result of normal_matrix()
+	enum class normal_scale
+	{
+		exact,    //transpose(inverse(m)), so transformed normals get the length they should
+		direction //transpose(inverse(m)) * |determinant(m)|, without the division, for normals normalized afterwards
+	};
+
+	//returns the matrix that transforms the normals of a mesh transformed by 'm': transpose(inverse(m))
+	//computed as the cross products of the columns of 'm' (its cofactors) over the determinant
+	//a singular 'm' (e.g. a zero scale) gives the cofactors without scaling, which still flatten normals correctly
+	constexpr mat3 normal_matrix(const mat3& m, normal_scale scale = normal_scale::exact);
+
+	//returns the normal matrix of the upper 3x3 part of 'm'
+	constexpr mat3 normal_matrix(const mat4& m, normal_scale scale = normal_scale::exact);
+
 	//returns a transform matrix (translation * rotation) from a starting position
 	//'start', looking at an ending position, 'end', with an up vector of 'up'
 	mat4 look_at(const vec3& start, const vec3& end, const vec3& up = vec3::up);
 
 	//creates a transform matrix (translation * rotation) from 'tran' and 'rot'
-	mat4 compose(const vec3& tran, const quat& rot);
+	constexpr mat4 compose(const vec3& tran, const quat& rot);
 
 	//creates a transform matrix (translation * rotation * scale) from 'tran', 'rot', and 'scale'
-	mat4 compose(const vec3& tran, const quat& rot, const vec3& scale);
+	constexpr mat4 compose(const vec3& tran, const quat& rot, const vec3& scale);
 
 	//creates a perspective projection matrix
 	//with a field of view of the value 'fov' (in radians)
@@ -293,43 +309,44 @@ namespace vcm
 	//with the x axis ranging from left to right
 	//with the y axis ranging from bottom to top
 	//and the z axis ranging from znear to zfar
-	mat4 orthographic(float left, float right, float bottom, float top, float znear, float zfar);
+	constexpr mat4 orthographic(float left, float right, float bottom, float top, float znear, float zfar);
+
+	//LAYOUT
+
+	VECMATH_LAYOUT(mat2, 4);
+	VECMATH_LAYOUT(mat3, 9);
+	VECMATH_LAYOUT(mat4, 16);
 
     //INLINE CONSTRUCTORS
 
     //MAT2
 
-    inline mat2::mat2()
+    constexpr mat2::mat2()
     {
         m[0] = { 1, 0 };
         m[1] = { 0, 1 };
     }
 
-    inline mat2::mat2(float all)
+    constexpr mat2::mat2(float all)
     {
         m[0] = vcm::vec2{ all };
         m[1] = vcm::vec2{ all };
     }
 
-    inline mat2::mat2(const vec2& a, const vec2& b)
+    constexpr mat2::mat2(const vec2& a, const vec2& b)
     {
         m[0] = a;
         m[1] = b;
     }
 
-    inline mat2::mat2(const mat2& other)
-    {
-        m[0] = other.m[0];
-        m[1] = other.m[1];
-    }
 
-    inline mat2::mat2(const mat3& other)
+    constexpr mat2::mat2(const mat3& other)
     {
         m[0] = (vcm::vec2)other.m[0];
         m[1] = (vcm::vec2)other.m[1];
     }
 
-    inline mat2::mat2(const mat4& other)
+    constexpr mat2::mat2(const mat4& other)
     {
         m[0] = (vcm::vec2)other.m[0];
         m[1] = (vcm::vec2)other.m[1];
@@ -337,42 +354,36 @@ namespace vcm
 
     //MAT3
 
-    inline mat3::mat3()
+    constexpr mat3::mat3()
     {
         m[0] = { 1, 0, 0 };
         m[1] = { 0, 1, 0 };
         m[2] = { 0, 0, 1 };
     }
 
-    inline mat3::mat3(float all)
+    constexpr mat3::mat3(float all)
     {
         m[0] = vcm::vec3{ all };
         m[1] = vcm::vec3{ all };
         m[2] = vcm::vec3{ all };
     }
 
-    inline mat3::mat3(const vec3& a, const vec3& b, const vec3& c)
+    constexpr mat3::mat3(const vec3& a, const vec3& b, const vec3& c)
     {
         m[0] = a;
         m[1] = b;
         m[2] = c;
     }
 
-    inline mat3::mat3(const mat3& other)
-    {
-        m[0] = other.m[0];
-        m[1] = other.m[1];
-        m[2] = other.m[2];
-    }
 
-    inline mat3::mat3(const mat2& other)
+    constexpr mat3::mat3(const mat2& other)
     {
         m[0] = (vcm::vec3)other.m[0];
         m[1] = (vcm::vec3)other.m[1];
         m[2] = { 0, 0, 1 };
     }
 
-    inline mat3::mat3(const mat4& other)
+    constexpr mat3::mat3(const mat4& other)
     {
         m[0] = (vcm::vec3)other.m[0];
         m[1] = (vcm::vec3)other.m[1];
@@ -381,7 +392,7 @@ namespace vcm
 
     //MAT4
 
-    inline mat4::mat4()
+    constexpr mat4::mat4()
     {
         m[0] = { 1, 0, 0, 0 };
         m[1] = { 0, 1, 0, 0 };
@@ -389,7 +400,7 @@ namespace vcm
         m[3] = { 0, 0, 0, 1 };
     }
 
-    inline mat4::mat4(float all)
+    constexpr mat4::mat4(float all)
     {
         m[0] = vcm::vec4{ all };
         m[1] = vcm::vec4{ all };
@@ -397,7 +408,7 @@ namespace vcm
         m[3] = vcm::vec4{ all };
     }
 
-    inline mat4::mat4(const vec4& a, const vec4& b, const vec4& c, const vec4& d)
+    constexpr mat4::mat4(const vec4& a, const vec4& b, const vec4& c, const vec4& d)
     {
         m[0] = a;
         m[1] = b;
@@ -405,15 +416,8 @@ namespace vcm
         m[3] = d;
     }
 
-    inline mat4::mat4(const mat4& other)
-    {
-        m[0] = other.m[0];
-        m[1] = other.m[1];
-        m[2] = other.m[2];
-        m[3] = other.m[3];
-    }
 
-    inline mat4::mat4(const mat2& other)
+    constexpr mat4::mat4(const mat2& other)
     {
         m[0] = (vcm::vec4)other.m[0];
         m[1] = (vcm::vec4)other.m[1];
@@ -421,13 +425,255 @@ namespace vcm
         m[3] = { 0, 0, 0, 1 };
     }
 
-    inline mat4::mat4(const mat3& other)
+    constexpr mat4::mat4(const mat3& other)
     {
         m[0] = (vcm::vec4)other.m[0];
         m[1] = (vcm::vec4)other.m[1];
         m[2] = (vcm::vec4)other.m[2];
         m[3] = { 0, 0, 0, 1 };
     }
+
+    //CONSTEXPR FUNCTIONS
+
+    constexpr mat2 mat2::operator*(const mat2& other) const
+    {
+        mat2 result;
+
+        auto row0 = row(0);
+        auto row1 = row(1);
+
+        result.m[0][0] = dot(row0, other.m[0]);
+        result.m[0][1] = dot(row1, other.m[0]);
+
+        result.m[1][0] = dot(row0, other.m[1]);
+        result.m[1][1] = dot(row1, other.m[1]);
+
+        return result;
+    }
+
+    constexpr vec2 mat2::operator*(const vec2& other) const
+    {
+        vec2 result;
+
+        result.x = dot(row(0), other);
+        result.y = dot(row(1), other);
+
+        return result;
+    }
+
+    constexpr mat2 transpose(const mat2& m)
+    {
+        return mat2(m.row(0), m.row(1));
+    }
+
+    constexpr float determinant(const mat2& m)
+    {
+        return m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    }
+
+    constexpr mat3::mat3(const quat& other)
+    {
+        quat q = normalize(other);
+
+        m[0] =
+        {
+            1 - 2 * q.y * q.y - 2 * q.z * q.z,
+            2 * q.x * q.y + 2 * q.z * q.w,
+            2 * q.x * q.z - 2 * q.y * q.w
+        };
+
+        m[1] =
+        {
+            2 * q.x * q.y - 2 * q.z * q.w,
+            1 - 2 * q.x * q.x - 2 * q.z * q.z,
+            2 * q.y * q.z + 2 * q.x * q.w
+        };
+
+        m[2] =
+        {
+            2 * q.x * q.z + 2 * q.y * q.w,
+            2 * q.y * q.z - 2 * q.x * q.w,
+            1 - 2 * q.x * q.x - 2 * q.y * q.y
+        };
+    }
+
+    constexpr mat3 mat3::operator*(const mat3& other) const
+    {
+        mat3 result;
+
+        auto row0 = row(0);
+        auto row1 = row(1);
+        auto row2 = row(2);
+
+        result.m[0][0] = dot(row0, other.m[0]);
+        result.m[0][1] = dot(row1, other.m[0]);
+        result.m[0][2] = dot(row2, other.m[0]);
+
+        result.m[1][0] = dot(row0, other.m[1]);
+        result.m[1][1] = dot(row1, other.m[1]);
+        result.m[1][2] = dot(row2, other.m[1]);
+
+        result.m[2][0] = dot(row0, other.m[2]);
+        result.m[2][1] = dot(row1, other.m[2]);
+        result.m[2][2] = dot(row2, other.m[2]);
+
+        return result;
+    }
+
+    constexpr vec3 mat3::operator*(const vec3& other) const
+    {
+        vec3 result;
+
+        result.x = dot(row(0), other);
+        result.y = dot(row(1), other);
+        result.z = dot(row(2), other);
+
+        return result;
+    }
+
+    constexpr mat3 transpose(const mat3& m)
+    {
+        return mat3(m.row(0), m.row(1), m.row(2));
+    }
+
+    constexpr float determinant(const mat3& m)
+    {
+        float result =
+            (m[0][0] * determinant(mat2({ m[1][1], m[1][2] }, { m[2][1], m[2][2] }))) -
+            (m[1][0] * determinant(mat2({ m[0][1], m[0][2] }, { m[2][1], m[2][2] }))) +
+            (m[2][0] * determinant(mat2({ m[0][1], m[0][2] }, { m[1][1], m[1][2] })));
+
+        return result;
+    }
+
+    constexpr mat4 detail::product(const mat4& a, const mat4& b)
+    {
+        mat4 result;
+
+        auto row0 = a.row(0);
+        auto row1 = a.row(1);
+        auto row2 = a.row(2);
+        auto row3 = a.row(3);
+
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            result.m[i][0] = dot(row0, b.m[i]);
+            result.m[i][1] = dot(row1, b.m[i]);
+            result.m[i][2] = dot(row2, b.m[i]);
+            result.m[i][3] = dot(row3, b.m[i]);
+        }
+
+        return result;
+    }
+
+    constexpr vec4 detail::product(const mat4& a, const vec4& v)
+    {
+        vec4 result;
+
+        result.x = dot(a.row(0), v);
+        result.y = dot(a.row(1), v);
+        result.z = dot(a.row(2), v);
+        result.w = dot(a.row(3), v);
+
+        return result;
+    }
+
+    constexpr mat4 mat4::operator*(const mat4& other) const
+    {
+        if (VECMATH_CONSTANT_EVALUATED())
+            return detail::product(*this, other);
+
+        return detail::multiply(*this, other);
+    }
+
+    constexpr vec4 mat4::operator*(const vec4& other) const
+    {
+        if (VECMATH_CONSTANT_EVALUATED())
+            return detail::product(*this, other);
+
+        return detail::multiply(*this, other);
+    }
+
+    constexpr mat4 transpose(const mat4& m)
+    {
+        return mat4(m.row(0), m.row(1), m.row(2), m.row(3));
+    }
+
+    constexpr float determinant(const mat4& m)
+    {
+        //laplace expansion over the 2x2 sub-determinants of the first two and last two columns
+        float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+        float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+        float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+        float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+        float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+        float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+        float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+        float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+        float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+        float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+        float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+        float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+
+    constexpr mat4 compose(const vec3& tran, const quat& rot)
+    {
+        mat4 result = (mat4)mat3(rot);
+        result.m[3] = { tran, 1 };
+
+        return result;
+    }
+
+    constexpr mat4 compose(const vec3& tran, const quat& rot, const vec3& scale)
+    {
+        mat4 result = (mat4)mat3(rot);
+        result.m[0] *= scale.x;
+        result.m[1] *= scale.y;
+        result.m[2] *= scale.z;
+        result.m[3] = { tran, 1 };
+
+        return result;
+    }
+
+    constexpr mat3 normal_matrix(const mat3& m, normal_scale scale)
+    {
+        //transpose(inverse(m)) has the columns cross(c1, c2), cross(c2, c0), and cross(c0, c1) over the determinant
+        vec3 r0 = cross(m.m[1], m.m[2]);
+        vec3 r1 = cross(m.m[2], m.m[0]);
+        vec3 r2 = cross(m.m[0], m.m[1]);
+
+        float det = dot(m.m[0], r0);
+        float s = det == 0 ? 1.0f : scale == normal_scale::exact ? 1.0f / det : det < 0 ? -1.0f : 1.0f;
+
+        return mat3(r0 * s, r1 * s, r2 * s);
+    }
+
+    constexpr mat3 normal_matrix(const mat4& m, normal_scale scale)
+    {
+        return normal_matrix(mat3(m), scale);
+    }
+
+    constexpr mat4 orthographic(float left, float right, float bottom, float top, float znear, float zfar)
+    {
+        mat4 result;
+
+        result.m[0][0] = 2.0f / (right - left);
+        result.m[1][1] = 2.0f / (top - bottom);
+        result.m[2][2] = -2.0f / (zfar - znear);
+        result.m[3][0] = -(right + left) / (right - left);
+        result.m[3][1] = -(top + bottom) / (top - bottom);
+        result.m[3][2] = -(zfar + znear) / (zfar - znear);
+        result.m[3][3] = 1;
+
+        return result;
+    }
 }
 
+#ifdef VECMATH_HEADER_ONLY
+#include "matrix.inl"
+#endif
+
 #endif
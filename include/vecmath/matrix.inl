@@ -0,0 +1,287 @@
+#ifndef VECMATH_MATRIX_INL
+#define VECMATH_MATRIX_INL
+
+//definitions of the functions declared in matrix.hpp that aren't constexpr (those are defined in matrix.hpp)
+//included by matrix.hpp when VECMATH_HEADER_ONLY is defined, otherwise compiled into src/matrix.cpp
+
+#include "matrix.hpp"
+#include "simd.hpp"
+
+#include <cmath>
+
+namespace vcm
+{
+	VECMATH_INLINE quat::quat(const mat3& mat) 
+	{
+		float trace = mat[0][0] + mat[1][1] + mat[2][2];
+
+		if (trace > 0) 
+		{
+			float s = std::sqrt(trace + 1.0f) * 2;
+			w = 0.25f * s;
+			x = (mat[1][2] - mat[2][1]) / s;
+			y = (mat[2][0] - mat[0][2]) / s;
+			z = (mat[0][1] - mat[1][0]) / s;
+		}
+		else if ((mat[0][0] > mat[1][1]) && (mat[0][0] > mat[2][2])) 
+		{
+			float s = std::sqrt(1.0f + mat[0][0] - mat[1][1] - mat[2][2]) * 2;
+			w = (mat[1][2] - mat[2][1]) / s;
+			x = 0.25f * s;
+			y = (mat[1][0] + mat[0][1]) / s;
+			z = (mat[2][0] + mat[0][2]) / s;
+		}
+		else if (mat[1][1] > mat[2][2]) 
+		{
+			float s = std::sqrt(1.0f + mat[1][1] - mat[0][0] - mat[2][2]) * 2;
+			w = (mat[2][0] - mat[0][2]) / s;
+			x = (mat[1][0] + mat[0][1]) / s;
+			y = 0.25f * s;
+			z = (mat[2][1] + mat[1][2]) / s;
+		}
+		else {
+			float s = std::sqrt(1.0f + mat[2][2] - mat[0][0] - mat[1][1]) * 2;
+			w = (mat[0][1] - mat[1][0]) / s;
+			x = (mat[2][0] + mat[0][2]) / s;
+			y = (mat[2][1] + mat[1][2]) / s;
+			z = 0.25f * s;
+		}
+	}
+
+	VECMATH_INLINE mat2 inverse(const mat2& m) 
+	{
+		auto dt = determinant(m);
+		if (dt == 0)
+			return m;
+
+		mat2 result;
+
+		result.m[0][0] = m.m[1][1];
+		result.m[0][1] = -m.m[0][1];
+		result.m[1][0] = -m.m[1][0];
+		result.m[1][1] = m.m[0][0];
+
+		return result * (1.0f / dt);
+	}
+
+	VECMATH_INLINE mat2 from_angle(float angle) 
+	{
+        auto c = std::cos(angle);
+        auto s = std::sin(angle);
+
+		mat2 result = 
+		{
+			{ c, s },
+			{ -s, c }
+		};
+
+		return result;
+	}
+
+	VECMATH_INLINE mat3 inverse(const mat3& m) 
+	{
+		float dt = determinant(m);
+		if (dt == 0)
+			return m;
+
+		mat3 result;
+
+		result[0][0] = determinant(mat2({ m[1][1], m[1][2] }, { m[2][1], m[2][2] }));
+		result[0][1] = -determinant(mat2({ m[1][0], m[1][2] }, { m[2][0], m[2][2] }));
+		result[0][2] = determinant(mat2({ m[1][0], m[1][1] }, { m[2][0], m[2][1] }));
+
+		result[1][0] = -determinant(mat2({ m[0][1], m[0][2] }, { m[2][1], m[2][2] }));
+		result[1][1] = determinant(mat2({ m[0][0], m[0][2] }, { m[2][0], m[2][2] }));
+		result[1][2] = -determinant(mat2({ m[0][0], m[0][1] }, { m[2][0], m[2][1] }));
+
+		result[2][0] = determinant(mat2({ m[0][1], m[0][2] }, { m[1][1], m[1][2] }));
+		result[2][1] = -determinant(mat2({ m[0][0], m[0][2] }, { m[1][0], m[1][2] }));
+		result[2][2] = determinant(mat2({ m[0][0], m[0][1] }, { m[1][0], m[1][1] }));
+
+		return transpose(result) * (1.0f / dt);
+	}
+
+	VECMATH_INLINE mat3 look_rotation(const vec3& fwd, const vec3& up) 
+	{
+		auto r = cross(fwd, up);
+		auto u = cross(r, fwd);
+
+		return mat3(normalize(r), normalize(u), normalize(-fwd));
+	}
+
+	VECMATH_INLINE mat4 detail::multiply(const mat4& a, const mat4& b)
+	{
+		mat4 result;
+
+#if defined(VECMATH_USE_AVX)
+		//two result columns per iteration, each a linear combination of the columns of 'a'
+		const __m256 c0 = _mm256_broadcast_ps((const __m128*)a.m[0].m);
+		const __m256 c1 = _mm256_broadcast_ps((const __m128*)a.m[1].m);
+		const __m256 c2 = _mm256_broadcast_ps((const __m128*)a.m[2].m);
+		const __m256 c3 = _mm256_broadcast_ps((const __m128*)a.m[3].m);
+
+		for (unsigned i = 0; i < 4; i += 2) 
+		{
+			__m256 bi = _mm256_loadu_ps(b.m[i].m);
+
+			__m256 r = _mm256_mul_ps(c0, _mm256_permute_ps(bi, 0x00));
+			r = _mm256_fmadd_ps(c1, _mm256_permute_ps(bi, 0x55), r);
+			r = _mm256_fmadd_ps(c2, _mm256_permute_ps(bi, 0xAA), r);
+			r = _mm256_fmadd_ps(c3, _mm256_permute_ps(bi, 0xFF), r);
+
+			_mm256_storeu_ps(result.m[i].m, r);
+		}
+#elif defined(VECMATH_USE_SSE)
+		//each result column is a linear combination of the columns of 'a'
+		const __m128 c0 = _mm_loadu_ps(a.m[0].m);
+		const __m128 c1 = _mm_loadu_ps(a.m[1].m);
+		const __m128 c2 = _mm_loadu_ps(a.m[2].m);
+		const __m128 c3 = _mm_loadu_ps(a.m[3].m);
+
+		for (unsigned i = 0; i < 4; ++i) 
+		{
+			__m128 bi = _mm_loadu_ps(b.m[i].m);
+
+			__m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(bi, bi, 0x00));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(bi, bi, 0x55)));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(bi, bi, 0xAA)));
+			r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(bi, bi, 0xFF)));
+
+			_mm_storeu_ps(result.m[i].m, r);
+		}
+#else
+		result = product(a, b);
+#endif
+
+		return result;
+	}
+
+	VECMATH_INLINE vec4 detail::multiply(const mat4& a, const vec4& v)
+	{
+		vec4 result;
+
+#if defined(VECMATH_USE_AVX)
+		__m128 x = _mm_loadu_ps(v.m);
+
+		__m128 r = _mm_mul_ps(_mm_loadu_ps(a.m[0].m), _mm_shuffle_ps(x, x, 0x00));
+		r = _mm_fmadd_ps(_mm_loadu_ps(a.m[1].m), _mm_shuffle_ps(x, x, 0x55), r);
+		r = _mm_fmadd_ps(_mm_loadu_ps(a.m[2].m), _mm_shuffle_ps(x, x, 0xAA), r);
+		r = _mm_fmadd_ps(_mm_loadu_ps(a.m[3].m), _mm_shuffle_ps(x, x, 0xFF), r);
+
+		_mm_storeu_ps(result.m, r);
+#elif defined(VECMATH_USE_SSE)
+		__m128 x = _mm_loadu_ps(v.m);
+
+		__m128 r = _mm_mul_ps(_mm_loadu_ps(a.m[0].m), _mm_shuffle_ps(x, x, 0x00));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.m[1].m), _mm_shuffle_ps(x, x, 0x55)));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.m[2].m), _mm_shuffle_ps(x, x, 0xAA)));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a.m[3].m), _mm_shuffle_ps(x, x, 0xFF)));
+
+		_mm_storeu_ps(result.m, r);
+#else
+		result = product(a, v);
+#endif
+
+		return result;
+	}
+
+	VECMATH_INLINE mat4 inverse(const mat4& m) 
+	{
+		//the same sub-determinants as determinant(), shared by every cofactor
+		float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+		float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+		float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+		float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+		float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+		float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+		float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+		float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+		float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+		float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+		float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+		float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+		float dt = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		if (dt == 0)
+			return m;
+
+		float inv = 1.0f / dt;
+		mat4 result;
+
+		result[0][0] = (m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * inv;
+		result[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * inv;
+		result[0][2] = (m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * inv;
+		result[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * inv;
+
+		result[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * inv;
+		result[1][1] = (m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * inv;
+		result[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * inv;
+		result[1][3] = (m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * inv;
+
+		result[2][0] = (m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * inv;
+		result[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * inv;
+		result[2][2] = (m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * inv;
+		result[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * inv;
+
+		result[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * inv;
+		result[3][1] = (m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * inv;
+		result[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * inv;
+		result[3][3] = (m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * inv;
+
+		return result;
+	}
+
+	VECMATH_INLINE mat4 inverse_affine(const mat4& m) 
+	{
+		//the columns of the rotation * scale block are r[i] * s[i], so the rows of its
+		//inverse are the same columns divided by their squared lengths (s[i] * s[i])
+		vec3 c0(m.m[0]), c1(m.m[1]), c2(m.m[2]);
+
+		float l0 = dot(c0, c0);
+		float l1 = dot(c1, c1);
+		float l2 = dot(c2, c2);
+
+		if (l0 == 0 || l1 == 0 || l2 == 0)
+			return m;
+
+		c0 *= 1.0f / l0;
+		c1 *= 1.0f / l1;
+		c2 *= 1.0f / l2;
+
+		vec3 t(m.m[3]);
+
+		mat4 result;
+
+		result.m[0] = { c0.x, c1.x, c2.x, 0 };
+		result.m[1] = { c0.y, c1.y, c2.y, 0 };
+		result.m[2] = { c0.z, c1.z, c2.z, 0 };
+		result.m[3] = { -dot(c0, t), -dot(c1, t), -dot(c2, t), 1 };
+
+		return result;
+	}
+
+	VECMATH_INLINE mat4 perspective(float fov, float aspect, float znear, float zfar) 
+	{
+		mat4 result;
+		float f = std::tan(fov * 0.5f);
+
+		result.m[0][0] = 1.0f / (aspect * f);
+		result.m[1][1] = 1.0f / f;
+		result.m[2][2] = -(zfar + znear) / (zfar - znear);
+		result.m[2][3] = -1;
+		result.m[3][2] = -(2 * zfar * znear) / (zfar - znear);
+		result.m[3][3] = 0;
+
+		return result;
+	}
+
+	VECMATH_INLINE mat4 look_at(const vec3& start, const vec3& end, const vec3& up) 
+	{
+		mat4 result = (mat4)look_rotation(end - start, up);
+		result.m[3] = { start, 1 };
+		return result;
+	}
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef VECMATH_PACKED_H
+#define VECMATH_PACKED_H
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vcm
+{
+	//PACKED STORAGE
+	//compact formats for storing vectors and rotations in memory; they have no arithmetic,
+	//only conversions to and from the full precision types
+
+	//3 component vector of ieee 754 half precision floats (binary16 bits), 6 bytes
+	struct half3
+	{
+		std::uint16_t x, y, z;
+	};
+
+	//4 component vector of ieee 754 half precision floats (binary16 bits), 8 bytes
+	struct half4
+	{
+		std::uint16_t x, y, z, w;
+	};
+
+	//unit quaternion stored as its three smallest components ("smallest three"), 8 bytes
+	//the largest component is made positive (q and -q are the same rotation) and rebuilt from the others;
+	//the others lie in [-1 / sqrt(2), 1 / sqrt(2)] and are scaled to 16 bit snorm over that range,
+	//so each is within 1.1e-5 of the original, and the rebuilt largest component within 3.3e-5
+	struct packed_quat
+	{
+		std::int16_t a, b, c;  //the other components, in x, y, z, w order
+		std::uint16_t largest; //index of the largest component (0 to 3 for x to w)
+	};
+
+	//signed normalized 10:10:10:2 vector, 4 bytes; x in the lowest bits, then y, z, and w
+	//the layout of GL_INT_2_10_10_10_REV, so it can be used directly as a normalized vertex attribute
+	//x, y, and z are within 1 / 1022 of the original, w is -1, 0, or 1 (e.g. a tangent's handedness)
+	struct packed_normal
+	{
+		std::uint32_t v;
+	};
+
+	//returns 'f' as a half precision float, rounded to nearest even
+	//values too large for a half become infinity; nans stay nans
+	std::uint16_t to_half(float f);
+
+	//returns the half precision float 'h' as a float (exact)
+	float from_half(std::uint16_t h);
+
+	half3 pack_half(const vec3& v);
+	half4 pack_half(const vec4& v);
+	vec3 unpack_half(const half3& h);
+	vec4 unpack_half(const half4& h);
+
+	//returns the rotation 'q', which should have unit length, in the smallest three format
+	packed_quat pack_quat(const quat& q);
+
+	//returns the unit quaternion stored in 'p'
+	quat unpack_quat(const packed_quat& p);
+
+	//returns 'v' with each component clamped to [-1, 1] and quantized; w is 0
+	packed_normal pack_normal(const vec3& v);
+
+	//returns 'v' with each component clamped to [-1, 1] and quantized; w is rounded to -1, 0, or 1
+	packed_normal pack_normal(const vec4& v);
+
+	//returns the components of 'p' in [-1, 1]
+	vec4 unpack_normal(const packed_normal& p);
+
+	//BULK CONVERSION
+	//convert arrays of 'n' elements, several elements per iteration, with the same results as the
+	//single element functions (unpack_quats may differ in the last bit where multiply-adds are fused)
+	//the half conversions use F16C with the avx2 backend, SSE2 integer code with sse2 (see backend.hpp)
+
+	void pack_halves(const vec3* in, half3* out, std::size_t n);
+	void pack_halves(const vec4* in, half4* out, std::size_t n);
+	void unpack_halves(const half3* in, vec3* out, std::size_t n);
+	void unpack_halves(const half4* in, vec4* out, std::size_t n);
+
+	void pack_quats(const quat* in, packed_quat* out, std::size_t n);
+	void unpack_quats(const packed_quat* in, quat* out, std::size_t n);
+
+	void pack_normals(const vec3* in, packed_normal* out, std::size_t n);
+	void pack_normals(const vec4* in, packed_normal* out, std::size_t n);
+
+	//unpack_normals to vec3 drops w
+	void unpack_normals(const packed_normal* in, vec3* out, std::size_t n);
+	void unpack_normals(const packed_normal* in, vec4* out, std::size_t n);
+
+	namespace detail
+	{
+		//scale of the smallest three components, which lie in [-1 / sqrt(2), 1 / sqrt(2)]
+		inline constexpr float quat_snorm = 32767 * 1.41421356f;
+	}
+}
+
+#ifdef VECMATH_HEADER_ONLY
+#include "packed.inl"
+#endif
+
+#endif
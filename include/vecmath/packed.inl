@@ -0,0 +1,162 @@
+#ifndef VECMATH_PACKED_INL
+#define VECMATH_PACKED_INL
+
+//definitions of the functions declared in packed.hpp, apart from the bulk conversions
+//included by packed.hpp when VECMATH_HEADER_ONLY is defined, otherwise compiled into src/packed.cpp
+
+#include "packed.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace vcm
+{
+	VECMATH_INLINE std::uint16_t to_half(float f)
+	{
+		std::uint32_t u;
+		std::memcpy(&u, &f, sizeof(u));
+
+		std::uint32_t sign = (u >> 16) & 0x8000;
+		u &= 0x7fffffff;
+
+		std::uint32_t h;
+
+		if (u >= 0x47800000) //65536 and up, infinity, and nan
+		{
+			//nans are made quiet and keep the top bits of their payload, like F16C
+			h = u > 0x7f800000 ? 0x7e00 | ((u >> 13) & 0x3ff) : 0x7c00;
+		}
+		else if (u < 0x38800000) //below the smallest normal half
+		{
+			//adding 0.5 shifts the mantissa into place and rounds it to nearest even
+			float a;
+			std::memcpy(&a, &u, sizeof(a));
+			a += 0.5f;
+
+			std::memcpy(&h, &a, sizeof(h));
+			h -= 0x3f000000;
+		}
+		else
+		{
+			//rebias the exponent and round the 13 dropped mantissa bits to nearest even;
+			//a carry out of the mantissa correctly bumps the exponent, up to infinity
+			std::uint32_t odd = (u >> 13) & 1;
+			h = (u + 0xc8000fff + odd) >> 13;
+		}
+
+		return (std::uint16_t)(h | sign);
+	}
+
+	VECMATH_INLINE float from_half(std::uint16_t h)
+	{
+		//scaling by 2^112 rebiases the exponent and normalizes subnormals
+		std::uint32_t u = (std::uint32_t)(h & 0x7fff) << 13;
+
+		float f;
+		std::memcpy(&f, &u, sizeof(f));
+		f *= 0x1p112f;
+		std::memcpy(&u, &f, sizeof(u));
+
+		if ((h & 0x7c00) == 0x7c00) //infinity and nan
+			u |= 0x7f800000;
+
+		u |= (std::uint32_t)(h & 0x8000) << 16;
+
+		std::memcpy(&f, &u, sizeof(f));
+		return f;
+	}
+
+	VECMATH_INLINE half3 pack_half(const vec3& v)
+	{
+		return { to_half(v.x), to_half(v.y), to_half(v.z) };
+	}
+
+	VECMATH_INLINE half4 pack_half(const vec4& v)
+	{
+		return { to_half(v.x), to_half(v.y), to_half(v.z), to_half(v.w) };
+	}
+
+	VECMATH_INLINE vec3 unpack_half(const half3& h)
+	{
+		return { from_half(h.x), from_half(h.y), from_half(h.z) };
+	}
+
+	VECMATH_INLINE vec4 unpack_half(const half4& h)
+	{
+		return { from_half(h.x), from_half(h.y), from_half(h.z), from_half(h.w) };
+	}
+
+	VECMATH_INLINE packed_quat pack_quat(const quat& q)
+	{
+		//the largest magnitude, preferring w on ties so a zero quaternion unpacks to the identity
+		unsigned largest = 3;
+		float big = std::fabs(q.w);
+
+		for (unsigned i = 0; i < 3; ++i)
+		{
+			if (std::fabs(q.m[i]) > big)
+			{
+				big = std::fabs(q.m[i]);
+				largest = i;
+			}
+		}
+
+		float scale = q.m[largest] < 0 ? -detail::quat_snorm : detail::quat_snorm;
+
+		std::int16_t r[3];
+		unsigned k = 0;
+
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			if (i != largest)
+				r[k++] = (std::int16_t)std::nearbyint(std::fmin(std::fmax(q.m[i] * scale, -32767.0f), 32767.0f));
+		}
+
+		return { r[0], r[1], r[2], (std::uint16_t)largest };
+	}
+
+	VECMATH_INLINE quat unpack_quat(const packed_quat& p)
+	{
+		float a = p.a / detail::quat_snorm;
+		float b = p.b / detail::quat_snorm;
+		float c = p.c / detail::quat_snorm;
+		float l = std::sqrt(std::fmax(1 - (a * a + b * b + c * c), 0.0f));
+
+		switch (p.largest & 3)
+		{
+		case 0: return { l, a, b, c };
+		case 1: return { a, l, b, c };
+		case 2: return { a, b, l, c };
+		default: return { a, b, c, l };
+		}
+	}
+
+	VECMATH_INLINE packed_normal pack_normal(const vec3& v)
+	{
+		return pack_normal(vec4(v, 0));
+	}
+
+	VECMATH_INLINE packed_normal pack_normal(const vec4& v)
+	{
+		std::int32_t x = (std::int32_t)std::nearbyint(std::fmin(std::fmax(v.x, -1.0f), 1.0f) * 511);
+		std::int32_t y = (std::int32_t)std::nearbyint(std::fmin(std::fmax(v.y, -1.0f), 1.0f) * 511);
+		std::int32_t z = (std::int32_t)std::nearbyint(std::fmin(std::fmax(v.z, -1.0f), 1.0f) * 511);
+		std::int32_t w = (std::int32_t)std::nearbyint(std::fmin(std::fmax(v.w, -1.0f), 1.0f));
+
+		return { (std::uint32_t)(x & 0x3ff) | (std::uint32_t)(y & 0x3ff) << 10 | (std::uint32_t)(z & 0x3ff) << 20 | (std::uint32_t)(w & 3) << 30 };
+	}
+
+	VECMATH_INLINE vec4 unpack_normal(const packed_normal& p)
+	{
+		//shifting each field to the top and back sign extends it
+		std::int32_t x = (std::int32_t)(p.v << 22) >> 22;
+		std::int32_t y = (std::int32_t)(p.v << 12) >> 22;
+		std::int32_t z = (std::int32_t)(p.v << 2) >> 22;
+		std::int32_t w = (std::int32_t)p.v >> 30;
+
+		//-512 is the same as -511, as in opengl
+		return { std::fmax(x / 511.0f, -1.0f), std::fmax(y / 511.0f, -1.0f), std::fmax(z / 511.0f, -1.0f), std::fmax((float)w, -1.0f) };
+	}
+}
+
+#endif
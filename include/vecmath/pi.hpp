@@ -2,9 +2,9 @@
 #define VECMATH_PI_H
 
 namespace vcm {
-	extern const float PI;
-	extern const float RAD; //convert degrees to radians
-	extern const float DEG; //convert radians to degrees
+	inline constexpr float PI = 3.14159265359f;
+	inline constexpr float RAD = PI / 180.0f; //convert degrees to radians
+	inline constexpr float DEG = 180.0f / PI; //convert radians to degrees
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef VECMATH_POINTSTREAM_H
+#define VECMATH_POINTSTREAM_H
+
+#include "aabb.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vcm
+{
+	//POINT STREAMS
+	//transforms point sets too large to hold in memory (e.g. scans of billions of points) in one pass,
+	//bounding them on the way
+	//the points are transformed across simd lanes and split across up to 'threads' threads (0 means one per
+	//hardware thread); files hold tightly packed vec3s in the byte order of the machine
+
+	//transforms the 'n' points 'in' by 'm' (w = 1) into 'out', like transform_points(), and returns the box
+	//around the transformed points (empty for no points; components that are nan are left out)
+	//every point is transformed across simd lanes, also the last few, so the results don't depend on how a set
+	//is split into calls or threads (unlike transform_points(), whose last few points may differ in the last bit)
+	//'in' may be a mapped file, e.g. an array_file span, whose pages are then read by the threads as they go
+	aabb transform_points_bounds(const mat4& m, const vec3* in, vec3* out, std::size_t n, unsigned threads = 1);
+
+	//settings of the file pipelines
+	struct point_stream_options
+	{
+		std::uint64_t offset = 0;    //bytes before the first point of the input file, e.g. a header to skip
+		std::size_t chunk = 1 << 20; //points per chunk (12 MiB); three chunks are allocated
+		unsigned threads = 0;        //threads transforming each chunk
+	};
+
+	//transforms every point of the file 'in_path' by 'm' and writes them to 'out_path' (replacing it), writing
+	//the box around them to 'bounds'
+	//the file is processed a chunk at a time: while one chunk is transformed, the next one is read and the one
+	//before written on threads of their own, so a fast enough cpu only waits for the disk
+	//returns false if a file can't be opened or a read or write fails, with 'bounds' covering the points
+	//transformed until then; a partial point at the end of the input is ignored
+	bool transform_point_file(const mat4& m, const char* in_path, const char* out_path, aabb& bounds, const point_stream_options& options = point_stream_options());
+
+	//transforms the 'n' points 'in' by 'm' and writes them to 'out_path' (replacing it) a chunk at a time, like
+	//transform_point_file(), writing one chunk while the next is transformed; 'in' may be a mapped file
+	//(options.offset is ignored)
+	bool transform_point_file(const mat4& m, const vec3* in, std::uint64_t n, const char* out_path, aabb& bounds, const point_stream_options& options = point_stream_options());
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef VECMATH_SIMD_H
+#define VECMATH_SIMD_H
+
+//selects the instruction set of the inline kernels (the mat4 products in matrix.inl)
+//VECMATH_SSE and VECMATH_AVX are set by the build (see CMakeLists.txt)
+//if neither is usable on the target, the scalar reference code is used
+//the array functions choose their instruction set at run time instead, see backend.hpp
+
+#if defined(VECMATH_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define VECMATH_USE_SSE
+	#include <emmintrin.h>
+#endif
+
+#if defined(VECMATH_AVX) && defined(VECMATH_USE_SSE) && defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+	#define VECMATH_USE_AVX
+	#include <immintrin.h>
+#endif
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef VECMATH_SKINNING_H
+#define VECMATH_SKINNING_H
+
+#include "dualquat.hpp"
+#include "soa.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vcm
+{
+	//SKINNING
+	//deforms the vertices of a mesh by a palette of bone transforms (each bone's world transform times
+	//its inverse bind transform), blending the bones that influence each vertex
+	//the vertices are skinned several at a time across simd lanes, split across up to 'threads' threads
+	//(0 means one per hardware thread) when there are many
+	//'out_positions' and 'out_normals' are resized to match 'positions' and may be the input streams;
+	//'normals' must be the same size as 'positions'
+
+	//the bones influencing each vertex, stored vertex after vertex like a gpu vertex stream:
+	//vertex 'i' is influenced by the bones bones[i * count + k] with the weights weights[i * count + k]
+	struct skin_influences
+	{
+		const std::uint16_t* bones; //indices into the palette
+		const float* weights;       //summing to 1 for each vertex; unused influences have a weight of 0
+		unsigned count;             //influences per vertex, 4 or 8
+	};
+
+	//linear blend skinning: transforms the positions by the weighted sum of the matrices of their bones
+	//the matrices must be affine
+	void skin_linear(const mat4* palette, const skin_influences& influences, const vec3_soa& positions, vec3_soa& out_positions, unsigned threads = 1);
+
+	//linear blend skinning of positions and normals; the normals are transformed by the upper 3x3 part of
+	//the blended matrices and normalized, which is exact for bones without non-uniform scale
+	void skin_linear(const mat4* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa& normals, vec3_soa& out_positions, vec3_soa& out_normals, unsigned threads = 1);
+
+	//linear blend skinning with a palette of affine transforms
+	void skin_linear(const affine3* palette, const skin_influences& influences, const vec3_soa& positions, vec3_soa& out_positions, unsigned threads = 1);
+
+	//linear blend skinning of positions and normals with a palette of affine transforms
+	void skin_linear(const affine3* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa& normals, vec3_soa& out_positions, vec3_soa& out_normals, unsigned threads = 1);
+
+	//dual quaternion skinning: transforms the positions by the weighted sum of the dual quaternions of
+	//their bones, normalized, which keeps twisting joints from collapsing like blended matrices do
+	//the bones are blended in the hemisphere of the first influence (negated where dot(real, first real) < 0);
+	//the palette must be normalized and holds no scale
+	void skin_dual_quat(const dualquat* palette, const skin_influences& influences, const vec3_soa& positions, vec3_soa& out_positions, unsigned threads = 1);
+
+	//dual quaternion skinning of positions and normals; the normals are rotated by the blended rotations
+	void skin_dual_quat(const dualquat* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa& normals, vec3_soa& out_positions, vec3_soa& out_normals, unsigned threads = 1);
+}
+
+#endif
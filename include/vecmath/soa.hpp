@@ -0,0 +1,190 @@
+#ifndef VECMATH_SOA_H
+#define VECMATH_SOA_H
+
+#include "vector.hpp"
+
+#include <cstddef>
+
+namespace vcm
+{
+	//STRUCTURE OF ARRAYS
+	//streams of vectors stored as one array per component, so array kernels can work on
+	//whole simd registers of x, y, z (and w) at a time
+	//every component array is aligned to 64 bytes and zero padded to a multiple of 16 elements
+
+	//reference to an element of a vec3_soa, usable wherever a vec3 is expected
+	struct vec3_ref
+	{
+		operator vec3() const { return vec3(x, y, z); }
+
+		vec3_ref& operator=(const vec3& v)
+		{
+			x = v.x;
+			y = v.y;
+			z = v.z;
+
+			return *this;
+		}
+
+		vec3_ref& operator=(const vec3_ref& other)
+		{
+			return (*this = (vec3)other);
+		}
+
+		float& x;
+		float& y;
+		float& z;
+	};
+
+	//stream of 3 component vectors
+	struct vec3_soa
+	{
+		//creates an empty stream
+		vec3_soa();
+
+		//creates a stream of 'n' zero vectors
+		explicit vec3_soa(std::size_t n);
+
+		//creates a stream from the array of 'n' vectors, 'v'
+		vec3_soa(const vec3* v, std::size_t n);
+
+		vec3_soa(const vec3_soa& other);
+		vec3_soa(vec3_soa&& other);
+		~vec3_soa();
+
+		vec3_soa& operator=(const vec3_soa& other);
+		vec3_soa& operator=(vec3_soa&& other);
+
+		vec3_ref operator[](std::size_t i) { return vec3_ref{ x[i], y[i], z[i] }; }
+		vec3 operator[](std::size_t i) const { return vec3(x[i], y[i], z[i]); }
+
+		//returns the number of vectors in the stream
+		std::size_t size() const { return count; }
+
+		//resizes the stream to 'n' vectors, new vectors are zero
+		void resize(std::size_t n);
+
+		//replaces the contents of the stream with the array of 'n' vectors, 'v'
+		void assign(const vec3* v, std::size_t n);
+
+		//writes the stream to the array 'out', which must hold size() vectors
+		void store(vec3* out) const;
+
+		float* x;
+		float* y;
+		float* z;
+
+	private:
+		std::size_t count;
+		std::size_t capacity;
+	};
+
+	//reference to an element of a quat_soa, usable wherever a quat is expected
+	struct quat_ref
+	{
+		operator quat() const { return quat(x, y, z, w); }
+
+		quat_ref& operator=(const quat& q)
+		{
+			x = q.x;
+			y = q.y;
+			z = q.z;
+			w = q.w;
+
+			return *this;
+		}
+
+		quat_ref& operator=(const quat_ref& other)
+		{
+			return (*this = (quat)other);
+		}
+
+		float& x;
+		float& y;
+		float& z;
+		float& w;
+	};
+
+	//stream of quaternions
+	struct quat_soa
+	{
+		//creates an empty stream
+		quat_soa();
+
+		//creates a stream of 'n' identity quaternions
+		explicit quat_soa(std::size_t n);
+
+		//creates a stream from the array of 'n' quaternions, 'q'
+		quat_soa(const quat* q, std::size_t n);
+
+		quat_soa(const quat_soa& other);
+		quat_soa(quat_soa&& other);
+		~quat_soa();
+
+		quat_soa& operator=(const quat_soa& other);
+		quat_soa& operator=(quat_soa&& other);
+
+		quat_ref operator[](std::size_t i) { return quat_ref{ x[i], y[i], z[i], w[i] }; }
+		quat operator[](std::size_t i) const { return quat(x[i], y[i], z[i], w[i]); }
+
+		//returns the number of quaternions in the stream
+		std::size_t size() const { return count; }
+
+		//resizes the stream to 'n' quaternions, new quaternions are identity
+		void resize(std::size_t n);
+
+		//replaces the contents of the stream with the array of 'n' quaternions, 'q'
+		void assign(const quat* q, std::size_t n);
+
+		//writes the stream to the array 'out', which must hold size() quaternions
+		void store(quat* out) const;
+
+		float* x;
+		float* y;
+		float* z;
+		float* w;
+
+	private:
+		std::size_t count;
+		std::size_t capacity;
+	};
+
+	//STREAM FUNCTIONS
+	//'a' and 'b' must be the same size; 'out' is resized to match them and may be one of the inputs
+	//scalar results are written to 'out', which must hold size() floats
+
+	//writes the lengths of the vectors in 'v' to 'out'
+	void length(const vec3_soa& v, float* out);
+
+	//writes the dot products of the vectors in 'a' and 'b' to 'out'
+	void dot(const vec3_soa& a, const vec3_soa& b, float* out);
+
+	//writes the vectors in 'v', normalized, to 'out'
+	void normalize(const vec3_soa& v, vec3_soa& out);
+
+	//writes the cross products of the vectors in 'a' and 'b' to 'out'
+	void cross(const vec3_soa& a, const vec3_soa& b, vec3_soa& out);
+
+	//writes the vectors in 'a' and 'b' interpolated by a factor of 't' to 'out'
+	void lerp(const vec3_soa& a, const vec3_soa& b, float t, vec3_soa& out);
+
+	//writes the lengths of the quaternions in 'q' to 'out'
+	void length(const quat_soa& q, float* out);
+
+	//writes the dot products of the quaternions in 'a' and 'b' to 'out'
+	void dot(const quat_soa& a, const quat_soa& b, float* out);
+
+	//writes the quaternions in 'q', normalized, to 'out'
+	void normalize(const quat_soa& q, quat_soa& out);
+
+	//writes the quaternions in 'a' and 'b' interpolated by a factor of 't' (and normalized) to 'out'
+	void lerp(const quat_soa& a, const quat_soa& b, float t, quat_soa& out);
+
+	//writes the vectors in 'v' rotated by the quaternions in 'q', which must be normalized, to 'out'
+	void rotate(const quat_soa& q, const vec3_soa& v, vec3_soa& out);
+
+	//writes the vectors in 'v' rotated by the inverses of the quaternions in 'q' to 'out'
+	void inverse_rotate(const quat_soa& q, const vec3_soa& v, vec3_soa& out);
+}
+
+#endif
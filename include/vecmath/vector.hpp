@@ -1,53 +1,82 @@
 #ifndef VECMATH_VECTOR_H
 #define VECMATH_VECTOR_H
 
+#include "config.hpp"
 #include "fwd.hpp"
 
+#include <cmath>
+#include <limits>
+
 namespace vcm
 {	
+	namespace detail
+	{
+		//square root usable in constant expressions: newton's method in double precision while
+		//constant evaluated, std::sqrt at run time
+		constexpr float sqrt(float x)
+		{
+			if (!VECMATH_CONSTANT_EVALUATED())
+				return std::sqrt(x);
+
+			if (x < 0 || x != x)
+				return std::numeric_limits<float>::quiet_NaN();
+
+			if (x == 0 || x == std::numeric_limits<float>::infinity())
+				return x;
+
+			//starts above the root, so every step moves down until the result stops changing
+			double r = x > 1 ? x : 1;
+
+			for (;;)
+			{
+				double next = 0.5 * (r + x / r);
+				if (next >= r)
+					return (float)r;
+
+				r = next;
+			}
+		}
+	}
+
 	//2 component vector
 	struct vec2 
 	{
 		//creates a vector with all components equal to zero
-		vec2();
+		constexpr vec2();
 
 		//creates a vector with all components equal to 'all'
-		explicit vec2(float all);
+		explicit constexpr vec2(float all);
 
-		vec2(float x, float y);
+		constexpr vec2(float x, float y);
 
 		//creates a vector from an existing vector
-		vec2(const vec2& v);
+		constexpr vec2(const vec2& v) = default;
 
 		//creates a vector with all components set to the corresponding components of 'v'
-		explicit vec2(const vec3& v);
+		explicit constexpr vec2(const vec3& v);
 
 		//creates a vector with all components set to the corresponding components of 'v'
-		explicit vec2(const vec4& v);
+		explicit constexpr vec2(const vec4& v);
 
-		float& operator[](unsigned i) { return m[i]; }
-		float operator[](unsigned i) const { return m[i]; }
+		//constant expressions may only access the union member that was initialized,
+		//so there the components are picked by name; at run time the array is indexed
+		constexpr float& operator[](unsigned i) { return VECMATH_CONSTANT_EVALUATED() ? (i == 0 ? x : y) : m[i]; }
+		constexpr float operator[](unsigned i) const { return VECMATH_CONSTANT_EVALUATED() ? (i == 0 ? x : y) : m[i]; }
 
-		bool operator==(const vec2& other) const { return x == other.x && y == other.y; }
-		bool operator!=(const vec2& other) const { return x != other.x || y != other.y; }
+		constexpr bool operator==(const vec2& other) const { return x == other.x && y == other.y; }
+		constexpr bool operator!=(const vec2& other) const { return x != other.x || y != other.y; }
 
-		vec2 operator+(const vec2& other) const { return vec2(x + other.x, y + other.y); }
-		vec2 operator-(const vec2& other) const { return vec2(x - other.x, y - other.y); }
-		vec2 operator*(const vec2& other) const { return vec2(x * other.x, y * other.y); }
-		vec2 operator/(const vec2& other) const { return vec2(x / other.x, y / other.y); }
+		constexpr vec2 operator+(const vec2& other) const { return vec2(x + other.x, y + other.y); }
+		constexpr vec2 operator-(const vec2& other) const { return vec2(x - other.x, y - other.y); }
+		constexpr vec2 operator*(const vec2& other) const { return vec2(x * other.x, y * other.y); }
+		constexpr vec2 operator/(const vec2& other) const { return vec2(x / other.x, y / other.y); }
 
-		vec2 operator*(float scalar) const { return vec2(x * scalar, y * scalar); }
-		vec2 operator/(float scalar) const { return vec2(x / scalar, y / scalar); }
+		constexpr vec2 operator*(float scalar) const { return vec2(x * scalar, y * scalar); }
+		constexpr vec2 operator/(float scalar) const { return vec2(x / scalar, y / scalar); }
 
-		vec2& operator=(const vec2& other) 
-		{
-			x = other.x;
-			y = other.y;
+		constexpr vec2& operator=(const vec2& other) = default;
 
-			return *this;
-		}
-
-		vec2& operator+=(const vec2& other) 
+		constexpr vec2& operator+=(const vec2& other) 
 		{
 			x += other.x;
 			y += other.y;
@@ -55,7 +84,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec2& operator-=(const vec2& other) 
+		constexpr vec2& operator-=(const vec2& other) 
 		{
 			x -= other.x;
 			y -= other.y;
@@ -63,7 +92,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec2& operator*=(const vec2& other) 
+		constexpr vec2& operator*=(const vec2& other) 
 		{
 			x *= other.x;
 			y *= other.y;
@@ -71,7 +100,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec2& operator/=(const vec2& other) 
+		constexpr vec2& operator/=(const vec2& other) 
 		{
 			x /= other.x;
 			y /= other.y;
@@ -79,7 +108,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec2& operator*=(float scalar) 
+		constexpr vec2& operator*=(float scalar) 
 		{
 			x *= scalar;
 			y *= scalar;
@@ -87,7 +116,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec2& operator/=(float scalar) 
+		constexpr vec2& operator/=(float scalar) 
 		{
 			x /= scalar;
 			y /= scalar;
@@ -95,7 +124,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec2 operator-() const 
+		constexpr vec2 operator-() const 
 		{
 			return vec2(-x, -y);
 		}
@@ -113,19 +142,19 @@ namespace vcm
 	};
 
 	//returns the length of vector, 'v'
-	float length(const vec2& v);
+	constexpr float length(const vec2& v);
 
 	//returns the squared length of vector, 'v' (faster than length(v))
-	float length_squared(const vec2& v);
+	constexpr float length_squared(const vec2& v);
 
 	//returns the dot product of 'a' and 'b'
-	float dot(const vec2& a, const vec2& b);
+	constexpr float dot(const vec2& a, const vec2& b);
 
 	//returns 'v', normalized
-	vec2 normalize(const vec2& v);
+	constexpr vec2 normalize(const vec2& v);
 
 	//returns 'v' with its length clamped to a maximum value of 'maxLen'
-	vec2 clamp_length(const vec2& v, float maxLen);
+	constexpr vec2 clamp_length(const vec2& v, float maxLen);
 
 	//returns a vector with the largest components of 'a' and 'b'
 	vec2 max(const vec2& a, const vec2& b);
@@ -134,55 +163,48 @@ namespace vcm
 	vec2 min(const vec2& a, const vec2& b);
 
 	//returns the result 'a' and 'b' interpolated by a factor of 't'
-	vec2 lerp(const vec2& a, const vec2& b, float t);
+	constexpr vec2 lerp(const vec2& a, const vec2& b, float t);
 	
 	//3 component vector
 	struct vec3 
 	{
 		//creates a vector with all components equal to zero
-		vec3();
+		constexpr vec3();
 
 		//creates a vector with all components equal to 'all'
-		explicit vec3(float all);
+		explicit constexpr vec3(float all);
 
-		vec3(float x, float y, float z);
+		constexpr vec3(float x, float y, float z);
 
 		//creates a vector from an existing vector
-		vec3(const vec3& v);
+		constexpr vec3(const vec3& v) = default;
 
-		vec3(const vec2& xy, float z);
-		vec3(float x, const vec2& yz);
+		constexpr vec3(const vec2& xy, float z);
+		constexpr vec3(float x, const vec2& yz);
 
 		//creates a vector with the components equal to the corresponding components of 'v'
-		explicit vec3(const vec2& v);
+		explicit constexpr vec3(const vec2& v);
 
 		//creates a vector with the components equal to the corresponding components of 'v'
-		explicit vec3(const vec4& v);
-
-		float& operator[](unsigned i) { return m[i]; }
-		float operator[](unsigned i) const { return m[i]; }
+		explicit constexpr vec3(const vec4& v);
 
-		bool operator==(const vec3& other) const { return x == other.x && y == other.y && z == other.z; }
-		bool operator!=(const vec3& other) const { return x != other.x || y != other.y || z != other.z; }
+		constexpr float& operator[](unsigned i) { return VECMATH_CONSTANT_EVALUATED() ? (i == 0 ? x : i == 1 ? y : z) : m[i]; }
+		constexpr float operator[](unsigned i) const { return VECMATH_CONSTANT_EVALUATED() ? (i == 0 ? x : i == 1 ? y : z) : m[i]; }
 
-		vec3 operator+(const vec3& other) const { return vec3(x + other.x, y + other.y, z + other.z); }
-		vec3 operator-(const vec3& other) const { return vec3(x - other.x, y - other.y, z - other.z); }
-		vec3 operator*(const vec3& other) const { return vec3(x * other.x, y * other.y, z * other.z); }
-		vec3 operator/(const vec3& other) const { return vec3(x / other.x, y / other.y, z / other.z); }
+		constexpr bool operator==(const vec3& other) const { return x == other.x && y == other.y && z == other.z; }
+		constexpr bool operator!=(const vec3& other) const { return x != other.x || y != other.y || z != other.z; }
 
-		vec3 operator*(float scalar) const { return vec3(x * scalar, y * scalar, z * scalar); }
-		vec3 operator/(float scalar) const { return vec3(x / scalar, y / scalar, z / scalar); }
+		constexpr vec3 operator+(const vec3& other) const { return vec3(x + other.x, y + other.y, z + other.z); }
+		constexpr vec3 operator-(const vec3& other) const { return vec3(x - other.x, y - other.y, z - other.z); }
+		constexpr vec3 operator*(const vec3& other) const { return vec3(x * other.x, y * other.y, z * other.z); }
+		constexpr vec3 operator/(const vec3& other) const { return vec3(x / other.x, y / other.y, z / other.z); }
 
-		vec3& operator=(const vec3& other) 
-		{
-			x = other.x;
-			y = other.y;
-			z = other.z;
+		constexpr vec3 operator*(float scalar) const { return vec3(x * scalar, y * scalar, z * scalar); }
+		constexpr vec3 operator/(float scalar) const { return vec3(x / scalar, y / scalar, z / scalar); }
 
-			return *this;
-		}
+		constexpr vec3& operator=(const vec3& other) = default;
 
-		vec3& operator+=(const vec3& other) 
+		constexpr vec3& operator+=(const vec3& other) 
 		{
 			x += other.x;
 			y += other.y;
@@ -191,7 +213,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec3& operator-=(const vec3& other) 
+		constexpr vec3& operator-=(const vec3& other) 
 		{
 			x -= other.x;
 			y -= other.y;
@@ -200,7 +222,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec3& operator*=(const vec3& other) 
+		constexpr vec3& operator*=(const vec3& other) 
 		{
 			x *= other.x;
 			y *= other.y;
@@ -209,7 +231,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec3& operator/=(const vec3& other) 
+		constexpr vec3& operator/=(const vec3& other) 
 		{
 			x /= other.x;
 			y /= other.y;
@@ -218,7 +240,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec3& operator*=(float scalar) 
+		constexpr vec3& operator*=(float scalar) 
 		{
 			x *= scalar;
 			y *= scalar;
@@ -227,7 +249,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec3& operator/=(float scalar) 
+		constexpr vec3& operator/=(float scalar) 
 		{
 			x /= scalar;
 			y /= scalar;
@@ -236,7 +258,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec3 operator-() const 
+		constexpr vec3 operator-() const 
 		{
 			return vec3(-x, -y, -z);
 		}
@@ -256,19 +278,19 @@ namespace vcm
 	};
 
 	//returns the length of vector, 'v'
-	float length(const vec3& v);
+	constexpr float length(const vec3& v);
 
 	//returns the squared length of vector, 'v' (faster than length(v))
-	float length_squared(const vec3& v);
+	constexpr float length_squared(const vec3& v);
 
 	//returns the dot product of 'a' and 'b'
-	float dot(const vec3& a, const vec3& b);
+	constexpr float dot(const vec3& a, const vec3& b);
 
 	//returns 'v', normalized
-	vec3 normalize(const vec3& v);
+	constexpr vec3 normalize(const vec3& v);
 
 	//returns 'v' with its length clamped to a maximum value of 'maxLen'
-	vec3 clamp_length(const vec3& v, float maxLen);
+	constexpr vec3 clamp_length(const vec3& v, float maxLen);
 
 	//returns a vector with the largest components of 'a' and 'b'
 	vec3 max(const vec3& a, const vec3& b);
@@ -277,66 +299,58 @@ namespace vcm
 	vec3 min(const vec3& a, const vec3& b);
 
 	//returns the result 'a' and 'b' interpolated by a factor of 't'
-	vec3 lerp(const vec3& a, const vec3& b, float t);
+	constexpr vec3 lerp(const vec3& a, const vec3& b, float t);
 
 	//returns the cross product of 'a' and 'b'
-	vec3 cross(const vec3& a, const vec3& b);
+	constexpr vec3 cross(const vec3& a, const vec3& b);
 	
 	//4 component vector
 	struct vec4 
 	{
 		//creates a vector with all components equal to zero
-		vec4();
+		constexpr vec4();
 
 		//creates a vector with all components equal to 'all'
-		explicit vec4(float all);
+		explicit constexpr vec4(float all);
 
-		vec4(float x, float y, float z, float w);
+		constexpr vec4(float x, float y, float z, float w);
 
 		//creates a vector from an existing vector
-		vec4(const vec4& v);
+		constexpr vec4(const vec4& v) = default;
 
-		vec4(const vec3& xyz, float w);
-		vec4(float x, const vec3& yzw);
-		vec4(const vec2& xy, const vec2& zw);
-		vec4(const vec2& xy, float z, float w);
-		vec4(float x, const vec2& yz, float w);
-		vec4(float x, float y, const vec2& zw);
+		constexpr vec4(const vec3& xyz, float w);
+		constexpr vec4(float x, const vec3& yzw);
+		constexpr vec4(const vec2& xy, const vec2& zw);
+		constexpr vec4(const vec2& xy, float z, float w);
+		constexpr vec4(float x, const vec2& yz, float w);
+		constexpr vec4(float x, float y, const vec2& zw);
 
 		//creates a vector with all components set to the corresponding components of 'v'
-		explicit vec4(const vec2& v);
+		explicit constexpr vec4(const vec2& v);
 
 		//creates a vector with all components set to the corresponding components of 'v'
-		explicit vec4(const vec3& v);
+		explicit constexpr vec4(const vec3& v);
 
 		//creates a vector with all components set to the corresponding components of 'q'
-		explicit vec4(const quat& q);
-
-		float& operator[](unsigned i) { return m[i]; }
-		float operator[](unsigned i) const { return m[i]; }
+		explicit constexpr vec4(const quat& q);
 
-		bool operator==(const vec4& other) const { return x == other.x && y == other.y && z == other.z && w == other.w; }
-		bool operator!=(const vec4& other) const { return x != other.x || y != other.y || z != other.z || w != other.w; }
+		constexpr float& operator[](unsigned i) { return VECMATH_CONSTANT_EVALUATED() ? (i == 0 ? x : i == 1 ? y : i == 2 ? z : w) : m[i]; }
+		constexpr float operator[](unsigned i) const { return VECMATH_CONSTANT_EVALUATED() ? (i == 0 ? x : i == 1 ? y : i == 2 ? z : w) : m[i]; }
 
-		vec4 operator+(const vec4& other) const { return vec4(x + other.x, y + other.y, z + other.z, w + other.w); }
-		vec4 operator-(const vec4& other) const { return vec4(x - other.x, y - other.y, z - other.z, w - other.w); }
-		vec4 operator*(const vec4& other) const { return vec4(x * other.x, y * other.y, z * other.z, w * other.w); }
-		vec4 operator/(const vec4& other) const { return vec4(x / other.x, y / other.y, z / other.z, w / other.w); }
+		constexpr bool operator==(const vec4& other) const { return x == other.x && y == other.y && z == other.z && w == other.w; }
+		constexpr bool operator!=(const vec4& other) const { return x != other.x || y != other.y || z != other.z || w != other.w; }
 
-		vec4 operator*(float scalar) const { return vec4(x * scalar, y * scalar, z * scalar, w * scalar); }
-		vec4 operator/(float scalar) const { return vec4(x / scalar, y / scalar, z / scalar, w / scalar); }
+		constexpr vec4 operator+(const vec4& other) const { return vec4(x + other.x, y + other.y, z + other.z, w + other.w); }
+		constexpr vec4 operator-(const vec4& other) const { return vec4(x - other.x, y - other.y, z - other.z, w - other.w); }
+		constexpr vec4 operator*(const vec4& other) const { return vec4(x * other.x, y * other.y, z * other.z, w * other.w); }
+		constexpr vec4 operator/(const vec4& other) const { return vec4(x / other.x, y / other.y, z / other.z, w / other.w); }
 
-		vec4& operator=(const vec4& other) 
-		{
-			x = other.x;
-			y = other.y;
-			z = other.z;
-			w = other.w;
+		constexpr vec4 operator*(float scalar) const { return vec4(x * scalar, y * scalar, z * scalar, w * scalar); }
+		constexpr vec4 operator/(float scalar) const { return vec4(x / scalar, y / scalar, z / scalar, w / scalar); }
 
-			return *this;
-		}
+		constexpr vec4& operator=(const vec4& other) = default;
 
-		vec4& operator+=(const vec4& other) 
+		constexpr vec4& operator+=(const vec4& other) 
 		{
 			x += other.x;
 			y += other.y;
@@ -346,7 +360,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec4& operator-=(const vec4& other) 
+		constexpr vec4& operator-=(const vec4& other) 
 		{
 			x -= other.x;
 			y -= other.y;
@@ -356,7 +370,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec4& operator*=(const vec4& other) 
+		constexpr vec4& operator*=(const vec4& other) 
 		{
 			x *= other.x;
 			y *= other.y;
@@ -366,7 +380,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec4& operator/=(const vec4& other) 
+		constexpr vec4& operator/=(const vec4& other) 
 		{
 			x /= other.x;
 			y /= other.y;
@@ -376,7 +390,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec4& operator*=(float scalar) 
+		constexpr vec4& operator*=(float scalar) 
 		{
 			x *= scalar;
 			y *= scalar;
@@ -386,7 +400,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec4& operator/=(float scalar) 
+		constexpr vec4& operator/=(float scalar) 
 		{
 			x /= scalar;
 			y /= scalar;
@@ -396,7 +410,7 @@ namespace vcm
 			return *this;
 		}
 
-		vec4 operator-() const 
+		constexpr vec4 operator-() const 
 		{
 			return vec4(-x, -y, -z, -w);
 		}
@@ -416,19 +430,19 @@ namespace vcm
 	};
 
 	//returns the length of vector, 'v'
-	float length(const vec4& v);
+	constexpr float length(const vec4& v);
 
 	//returns the squared length of vector, 'v' (faster than length(v))
-	float length_squared(const vec4& v);
+	constexpr float length_squared(const vec4& v);
 
 	//returns the dot product of 'a' and 'b'
-	float dot(const vec4& a, const vec4& b);
+	constexpr float dot(const vec4& a, const vec4& b);
 
 	//returns 'v', normalized
-	vec4 normalize(const vec4& v);
+	constexpr vec4 normalize(const vec4& v);
 
 	//returns 'v' with its length clamped to a maximum value of 'maxLen'
-	vec4 clamp_length(const vec4& v, float maxLen);
+	constexpr vec4 clamp_length(const vec4& v, float maxLen);
 
 	//returns a vector with the largest components of 'a' and 'b'
 	vec4 max(const vec4& a, const vec4& b);
@@ -437,53 +451,53 @@ namespace vcm
 	vec4 min(const vec4& a, const vec4& b);
 
 	//returns the result 'a' and 'b' interpolated by a factor of 't'
-	vec4 lerp(const vec4& a, const vec4& b, float t);
+	constexpr vec4 lerp(const vec4& a, const vec4& b, float t);
 	
 	//4 element rotation vector
 	struct quat 
 	{
 		//creates an identity quaternion
-		quat();
+		constexpr quat();
 
 		//creates a quaternion with every component set to 'all'
-		explicit quat(float all);
+		explicit constexpr quat(float all);
 
-		quat(float x, float y, float z, float w);
+		constexpr quat(float x, float y, float z, float w);
 
 		//creates a quaternion from an existing quaternion, 'q'
-		quat(const quat& q);
+		constexpr quat(const quat& q) = default;
 
-		quat(const vec3& xyz, float w);
-		quat(float x, const vec3& yzw);
-		quat(const vec2& xy, const vec2& zw);
-		quat(const vec2& xy, float z, float w);
-		quat(float x, const vec2& yz, float w);
-		quat(float x, float y, const vec2& zw);
+		constexpr quat(const vec3& xyz, float w);
+		constexpr quat(float x, const vec3& yzw);
+		constexpr quat(const vec2& xy, const vec2& zw);
+		constexpr quat(const vec2& xy, float z, float w);
+		constexpr quat(float x, const vec2& yz, float w);
+		constexpr quat(float x, float y, const vec2& zw);
 
 		//creates a quaternion with the first two components equal to the components of v
-		explicit quat(const vec2& v);
+		explicit constexpr quat(const vec2& v);
 
 		//creates a quaternion with the first two components equal to the components of v
-		explicit quat(const vec3& v);
+		explicit constexpr quat(const vec3& v);
 
 		//creates a quaternion with the components equal to the components of v
-		explicit quat(const vec4& v);
+		explicit constexpr quat(const vec4& v);
 
 		//creates a quaternion from an existing rotation matrix
 		explicit quat(const mat3& mat);
 
-		float& operator[](unsigned i) { return m[i]; }
-		float operator[](unsigned i) const { return m[i]; }
+		constexpr float& operator[](unsigned i) { return VECMATH_CONSTANT_EVALUATED() ? (i == 0 ? x : i == 1 ? y : i == 2 ? z : w) : m[i]; }
+		constexpr float operator[](unsigned i) const { return VECMATH_CONSTANT_EVALUATED() ? (i == 0 ? x : i == 1 ? y : i == 2 ? z : w) : m[i]; }
 
-		bool operator==(const quat& other) const { return x == other.x && y == other.y && z == other.z && w == other.w; }
-		bool operator!=(const quat& other) const { return x != other.x || y != other.y || z != other.z || w != other.w; }
+		constexpr bool operator==(const quat& other) const { return x == other.x && y == other.y && z == other.z && w == other.w; }
+		constexpr bool operator!=(const quat& other) const { return x != other.x || y != other.y || z != other.z || w != other.w; }
 
-		quat operator+(const quat& other) const { return quat(x + other.x, y + other.y, z + other.z, w + other.w); }
-		quat operator-(const quat& other) const { return quat(x - other.x, y - other.y, z - other.z, w - other.w); }
-		quat operator*(float scalar) const { return quat(x * scalar, y * scalar, z * scalar, w * scalar); }
-		quat operator/(float scalar) const { return quat(x / scalar, y / scalar, z / scalar, w / scalar); }
+		constexpr quat operator+(const quat& other) const { return quat(x + other.x, y + other.y, z + other.z, w + other.w); }
+		constexpr quat operator-(const quat& other) const { return quat(x - other.x, y - other.y, z - other.z, w - other.w); }
+		constexpr quat operator*(float scalar) const { return quat(x * scalar, y * scalar, z * scalar, w * scalar); }
+		constexpr quat operator/(float scalar) const { return quat(x / scalar, y / scalar, z / scalar, w / scalar); }
 
-		quat operator*(const quat& other) const 
+		constexpr quat operator*(const quat& other) const 
 		{
 			quat result = {
 				w * other.x + x * other.w + y * other.z - z * other.y,
@@ -495,17 +509,9 @@ namespace vcm
 			return result;
 		}
 
-		quat& operator=(const quat& other) 
-		{
-			x = other.x;
-			y = other.y;
-			z = other.z;
-			w = other.w;
+		constexpr quat& operator=(const quat& other) = default;
 
-			return *this;
-		}
-
-		quat& operator+=(const quat& other) 
+		constexpr quat& operator+=(const quat& other) 
 		{
 			x += other.x;
 			y += other.y;
@@ -515,7 +521,7 @@ namespace vcm
 			return *this;
 		}
 
-		quat& operator-=(const quat& other) 
+		constexpr quat& operator-=(const quat& other) 
 		{
 			x -= other.x;
 			y -= other.y;
@@ -525,12 +531,12 @@ namespace vcm
 			return *this;
 		}
 
-		quat& operator*=(const quat& other) 
+		constexpr quat& operator*=(const quat& other) 
 		{
 			return (*this = (*this * other));
 		}
 
-		quat& operator*=(float scalar) 
+		constexpr quat& operator*=(float scalar) 
 		{
 			x *= scalar;
 			y *= scalar;
@@ -540,7 +546,7 @@ namespace vcm
 			return *this;
 		}
 
-		quat& operator/=(float scalar) 
+		constexpr quat& operator/=(float scalar) 
 		{
 			x /= scalar;
 			y /= scalar;
@@ -550,7 +556,7 @@ namespace vcm
 			return *this;
 		}
 
-		quat operator-() const 
+		constexpr quat operator-() const 
 		{
 			return quat(-x, -y, -z, -w);
 		}
@@ -563,22 +569,22 @@ namespace vcm
 	};
 
 	//returns the length of quaternion, 'q'
-	float length(const quat& q);
+	constexpr float length(const quat& q);
 
 	//returns the squared length of quaternion, 'q' (faster than length)
-	float length_squared(const quat& q);
+	constexpr float length_squared(const quat& q);
 
 	//returns the dot product of two quaternions, 'a', and 'b'
-	float dot(const quat& a, const quat& b);
+	constexpr float dot(const quat& a, const quat& b);
 
 	//returns 'q', normalized
-	quat normalize(const quat& q);
+	constexpr quat normalize(const quat& q);
 
 	//returns the inverse of 'q'
-	quat inverse(const quat& q);
+	constexpr quat inverse(const quat& q);
 
 	//returns the result of 'a' and 'b' interpolated by a factor of 't'
-	quat lerp(const quat& a, const quat& b, float t);
+	constexpr quat lerp(const quat& a, const quat& b, float t);
 
 	//returns the result of 'a' and 'b' spherically interpolated by a factor of 't'
 	quat slerp(const quat& a, const quat& b, float t);
@@ -589,95 +595,313 @@ namespace vcm
 	//returns a quaternion from euler angles
 	quat euler(const vec3& euler);
 
+	//returns 'v' rotated by 'q', which must be normalized
+	//cheaper than mat3(q) * v, which normalizes 'q' and builds all nine elements first
+	constexpr vec3 rotate(const quat& q, const vec3& v);
+
+	//returns 'v' rotated by the inverse of 'q', which must be normalized
+	constexpr vec3 inverse_rotate(const quat& q, const vec3& v);
+
+	//LAYOUT
+
+	VECMATH_LAYOUT(vec2, 2);
+	VECMATH_LAYOUT(vec3, 3);
+	VECMATH_LAYOUT(vec4, 4);
+	VECMATH_LAYOUT(quat, 4);
+
     //INLINE CONSTRUCTORS
 
     //VEC2
 
-    inline vec2::vec2() : x(0), y(0) {}
+    constexpr vec2::vec2() : x(0), y(0) {}
 
-    inline vec2::vec2(float all) : x(all), y(all) {}
+    constexpr vec2::vec2(float all) : x(all), y(all) {}
 
-    inline vec2::vec2(float x, float y) : x(x), y(y) {}
+    constexpr vec2::vec2(float x, float y) : x(x), y(y) {}
 
-    inline vec2::vec2(const vec2& v) : x(v.x), y(v.y) {}
 
-    inline vec2::vec2(const vec3& v) : x(v.x), y(v.y) {}
+    constexpr vec2::vec2(const vec3& v) : x(v.x), y(v.y) {}
 
-    inline vec2::vec2(const vec4& v) : x(v.x), y(v.y) {}
+    constexpr vec2::vec2(const vec4& v) : x(v.x), y(v.y) {}
 
     //VEC3
 
-    inline vec3::vec3() : x(0), y(0), z(0) {}
+    constexpr vec3::vec3() : x(0), y(0), z(0) {}
 
-    inline vec3::vec3(float all) : x(all), y(all), z(all) {}
+    constexpr vec3::vec3(float all) : x(all), y(all), z(all) {}
 
-    inline vec3::vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr vec3::vec3(float x, float y, float z) : x(x), y(y), z(z) {}
 
-    inline vec3::vec3(const vec3& v) : x(v.x), y(v.y), z(v.z) {}
 
-    inline vec3::vec3(const vec2& xy, float z) : x(xy[0]), y(xy[1]), z(z) {}
+    constexpr vec3::vec3(const vec2& xy, float z) : x(xy[0]), y(xy[1]), z(z) {}
 
-    inline vec3::vec3(float x, const vec2& yz) : x(x), y(yz[0]), z(yz[1]) {}
+    constexpr vec3::vec3(float x, const vec2& yz) : x(x), y(yz[0]), z(yz[1]) {}
 
-    inline vec3::vec3(const vec2& v) : x(v.x), y(v.y), z(0) {}
+    constexpr vec3::vec3(const vec2& v) : x(v.x), y(v.y), z(0) {}
 
-    inline vec3::vec3(const vec4& v) : x(v.x), y(v.y), z(v.z) {}
+    constexpr vec3::vec3(const vec4& v) : x(v.x), y(v.y), z(v.z) {}
 
     //VEC4
 
-    inline vec4::vec4() : x(0), y(0), z(0), w(0) {}
+    constexpr vec4::vec4() : x(0), y(0), z(0), w(0) {}
 
-    inline vec4::vec4(float all) : x(all), y(all), z(all), w(all) {}
+    constexpr vec4::vec4(float all) : x(all), y(all), z(all), w(all) {}
 
-    inline vec4::vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr vec4::vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
 
-    inline vec4::vec4(const vec4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
 
-    inline vec4::vec4(const vec3& xyz, float w) : x(xyz[0]), y(xyz[1]), z(xyz[2]), w(w) {}
+    constexpr vec4::vec4(const vec3& xyz, float w) : x(xyz[0]), y(xyz[1]), z(xyz[2]), w(w) {}
 
-    inline vec4::vec4(float x, const vec3& yzw) : x(x), y(yzw[0]), z(yzw[1]), w(yzw[2]) {}
+    constexpr vec4::vec4(float x, const vec3& yzw) : x(x), y(yzw[0]), z(yzw[1]), w(yzw[2]) {}
 
-    inline vec4::vec4(const vec2& xy, const vec2& zw) : x(xy[0]), y(xy[1]), z(zw[0]), w(zw[1]) {}
+    constexpr vec4::vec4(const vec2& xy, const vec2& zw) : x(xy[0]), y(xy[1]), z(zw[0]), w(zw[1]) {}
 
-    inline vec4::vec4(const vec2& xy, float z, float w) : x(xy[0]), y(xy[1]), z(z), w(w) {}
+    constexpr vec4::vec4(const vec2& xy, float z, float w) : x(xy[0]), y(xy[1]), z(z), w(w) {}
 
-    inline vec4::vec4(float x, const vec2& yz, float w) : x(x), y(yz[0]), z(yz[1]), w(w) {}
+    constexpr vec4::vec4(float x, const vec2& yz, float w) : x(x), y(yz[0]), z(yz[1]), w(w) {}
 
-    inline vec4::vec4(float x, float y, const vec2& zw) : x(x), y(y), z(zw[0]), w(zw[1]) {}
+    constexpr vec4::vec4(float x, float y, const vec2& zw) : x(x), y(y), z(zw[0]), w(zw[1]) {}
 
-    inline vec4::vec4(const vec2& v) : x(v.x), y(v.y), z(0), w(0) {}
+    constexpr vec4::vec4(const vec2& v) : x(v.x), y(v.y), z(0), w(0) {}
 
-    inline vec4::vec4(const vec3& v) : x(v.x), y(v.y), z(v.z), w(0) {}
+    constexpr vec4::vec4(const vec3& v) : x(v.x), y(v.y), z(v.z), w(0) {}
 
-    inline vec4::vec4(const quat& q) : x(q.x), y(q.y), z(q.z), w(q.w) {}
+    constexpr vec4::vec4(const quat& q) : x(q.x), y(q.y), z(q.z), w(q.w) {}
 
     //QUAT
 
-    inline quat::quat() : x(0), y(0), z(0), w(1) {}
+    constexpr quat::quat() : x(0), y(0), z(0), w(1) {}
+
+    constexpr quat::quat(float all) : x(all), y(all), z(all), w(all) {}
+
+    constexpr quat::quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+
+    constexpr quat::quat(const vec3& xyz, float w) : x(xyz[0]), y(xyz[1]), z(xyz[2]), w(w) {}
+
+    constexpr quat::quat(float x, const vec3& yzw) : x(x), y(yzw[0]), z(yzw[1]), w(yzw[2]) {}
+
+    constexpr quat::quat(const vec2& xy, const vec2& zw) : x(xy[0]), y(xy[1]), z(zw[0]), w(zw[1]) {}
+
+    constexpr quat::quat(const vec2& xy, float z, float w) : x(xy[0]), y(xy[1]), z(z), w(w) {}
 
-    inline quat::quat(float all) : x(all), y(all), z(all), w(all) {}
+    constexpr quat::quat(float x, const vec2& yz, float w) : x(x), y(yz[0]), z(yz[1]), w(w) {}
 
-    inline quat::quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr quat::quat(float x, float y, const vec2& zw) : x(x), y(y), z(zw[0]), w(zw[1]) {}
 
-    inline quat::quat(const quat& q) : x(q.x), y(q.y), z(q.z), w(q.w) {}
+    constexpr quat::quat(const vec2& v) : x(v.x), y(v.y), z(0), w(1) {}
 
-    inline quat::quat(const vec3& xyz, float w) : x(xyz[0]), y(xyz[1]), z(xyz[2]), w(w) {}
+    constexpr quat::quat(const vec3& v) : x(v.x), y(v.y), z(v.z), w(1) {}
 
-    inline quat::quat(float x, const vec3& yzw) : x(x), y(yzw[0]), z(yzw[1]), w(yzw[2]) {}
+    constexpr quat::quat(const vec4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
 
-    inline quat::quat(const vec2& xy, const vec2& zw) : x(xy[0]), y(xy[1]), z(zw[0]), w(zw[1]) {}
+    //CONSTANTS
 
-    inline quat::quat(const vec2& xy, float z, float w) : x(xy[0]), y(xy[1]), z(z), w(w) {}
+    inline constexpr vec2 vec2::up = { 0, 1 };
+    inline constexpr vec2 vec2::down = { 0, -1 };
+    inline constexpr vec2 vec2::right = { 1, 0 };
+    inline constexpr vec2 vec2::left = { -1, 0 };
 
-    inline quat::quat(float x, const vec2& yz, float w) : x(x), y(yz[0]), z(yz[1]), w(w) {}
+    inline constexpr vec3 vec3::up = { 0, 1, 0 };
+    inline constexpr vec3 vec3::down = { 0, -1, 0 };
+    inline constexpr vec3 vec3::right = { 1, 0, 0 };
+    inline constexpr vec3 vec3::left = { -1, 0, 0 };
+    inline constexpr vec3 vec3::forward = { 0, 0, -1 };
+    inline constexpr vec3 vec3::back = { 0, 0, 1 };
 
-    inline quat::quat(float x, float y, const vec2& zw) : x(x), y(y), z(zw[0]), w(zw[1]) {}
+    inline constexpr vec4 vec4::up = { 0, 1, 0, 0 };
+    inline constexpr vec4 vec4::down = { 0, -1, 0, 0 };
+    inline constexpr vec4 vec4::right = { 1, 0, 0, 0 };
+    inline constexpr vec4 vec4::left = { -1, 0, 0, 0 };
+    inline constexpr vec4 vec4::forward = { 0, 0, -1, 0 };
+    inline constexpr vec4 vec4::back = { 0, 0, 1, 0 };
 
-    inline quat::quat(const vec2& v) : x(v.x), y(v.y), z(0), w(1) {}
+    //CONSTEXPR FUNCTIONS
 
-    inline quat::quat(const vec3& v) : x(v.x), y(v.y), z(v.z), w(1) {}
+    constexpr float length(const vec2& v)
+    {
+        return detail::sqrt(v.x * v.x + v.y * v.y);
+    }
 
-    inline quat::quat(const vec4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+    constexpr float length_squared(const vec2& v)
+    {
+        return v.x * v.x + v.y * v.y;
+    }
+
+    constexpr float dot(const vec2& a, const vec2& b)
+    {
+        return a.x * b.x + a.y * b.y;
+    }
+
+    constexpr vec2 normalize(const vec2& v)
+    {
+        float len = length(v);
+        if (len == 0)
+            return v;
+
+        return v * (1.0f / len);
+    }
+
+    constexpr vec2 clamp_length(const vec2& v, float maxLen)
+    {
+        if (maxLen == 0)
+            return v;
+
+        float len = length(v);
+        if (len < maxLen)
+            return v;
+
+        return v * (maxLen / len);
+    }
+
+    constexpr vec2 lerp(const vec2& a, const vec2& b, float t)
+    {
+        return a + (b - a) * t;
+    }
+
+    constexpr float length(const vec3& v)
+    {
+        return detail::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    }
+
+    constexpr float length_squared(const vec3& v)
+    {
+        return v.x * v.x + v.y * v.y + v.z * v.z;
+    }
+
+    constexpr float dot(const vec3& a, const vec3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    constexpr vec3 normalize(const vec3& v)
+    {
+        float len = length(v);
+        if (len == 0)
+            return v;
+
+        return v * (1.0f / len);
+    }
+
+    constexpr vec3 clamp_length(const vec3& v, float maxLen)
+    {
+        if (maxLen == 0)
+            return v;
+
+        float len = length(v);
+        if (len < maxLen)
+            return v;
+
+        return v * (maxLen / len);
+    }
+
+    constexpr vec3 lerp(const vec3& a, const vec3& b, float t)
+    {
+        return a + (b - a) * t;
+    }
+
+    constexpr vec3 cross(const vec3& a, const vec3& b)
+    {
+        return
+        {
+            a.y * b.z - a.z * b.y,
+            a.z * b.x - a.x * b.z,
+            a.x * b.y - a.y * b.x
+        };
+    }
+
+    constexpr float length(const vec4& v)
+    {
+        return detail::sqrt(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w);
+    }
+
+    constexpr float length_squared(const vec4& v)
+    {
+        return v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w;
+    }
+
+    constexpr float dot(const vec4& a, const vec4& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+
+    constexpr vec4 normalize(const vec4& v)
+    {
+        float len = length(v);
+        if (len == 0)
+            return v;
+
+        return v * (1.0f / len);
+    }
+
+    constexpr vec4 clamp_length(const vec4& v, float maxLen)
+    {
+        if (maxLen == 0)
+            return v;
+
+        float len = length(v);
+        if (len < maxLen)
+            return v;
+
+        return v * (maxLen / len);
+    }
+
+    constexpr vec4 lerp(const vec4& a, const vec4& b, float t)
+    {
+        return a + (b - a) * t;
+    }
+
+    constexpr float length(const quat& v)
+    {
+        return detail::sqrt(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w);
+    }
+
+    constexpr float length_squared(const quat& v)
+    {
+        return v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w;
+    }
+
+    constexpr float dot(const quat& a, const quat& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+
+    constexpr quat normalize(const quat& v)
+    {
+        float len = length(v);
+        if (len == 0)
+            return v;
+
+        return v * (1.0f / len);
+    }
+
+    constexpr quat inverse(const quat& q)
+    {
+        return quat(-q.x, -q.y, -q.z, q.w);
+    }
+
+    constexpr quat lerp(const quat& a, const quat& b, float t)
+    {
+        return normalize(a * (1.0f - t) + b * t);
+    }
+
+    constexpr vec3 rotate(const quat& q, const vec3& v)
+    {
+        //q * v * inverse(q) expanded: v + w * t + cross(q.xyz, t) with t = 2 * cross(q.xyz, v)
+        vec3 r(q.x, q.y, q.z);
+        vec3 t = cross(r, v) * 2;
+
+        return v + t * q.w + cross(r, t);
+    }
+
+    constexpr vec3 inverse_rotate(const quat& q, const vec3& v)
+    {
+        return rotate(inverse(q), v);
+    }
 }
 
+#ifdef VECMATH_HEADER_ONLY
+#include "vector.inl"
+#endif
+
 #endif
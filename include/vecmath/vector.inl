@@ -0,0 +1,113 @@
+#ifndef VECMATH_VECTOR_INL
+#define VECMATH_VECTOR_INL
+
+//definitions of the functions declared in vector.hpp that aren't constexpr (those are defined in vector.hpp)
+//included by vector.hpp when VECMATH_HEADER_ONLY is defined, otherwise compiled into src/vector.cpp
+
+#include "vector.hpp"
+
+#include <cmath>
+
+namespace vcm
+{
+	VECMATH_INLINE vec2 min(const vec2& a, const vec2& b) 
+	{
+		return { std::fmin(a.x, b.x), std::fmin(a.y, b.y) };
+	}
+
+	VECMATH_INLINE vec2 max(const vec2& a, const vec2& b) 
+	{
+		return { std::fmax(a.x, b.x), std::fmax(a.y, b.y) };
+	}
+
+	VECMATH_INLINE vec3 min(const vec3& a, const vec3& b) 
+	{
+		return { std::fmin(a.x, b.x), std::fmin(a.y, b.y), std::fmin(a.z, b.z) };
+	}
+
+	VECMATH_INLINE vec3 max(const vec3& a, const vec3& b) 
+	{
+		return { std::fmax(a.x, b.x), std::fmax(a.y, b.y), std::fmax(a.z, b.z) };
+	}
+
+	VECMATH_INLINE vec4 min(const vec4& a, const vec4& b) 
+	{
+		return { std::fmin(a.x, b.x), std::fmin(a.y, b.y), std::fmin(a.z, b.z), std::fmin(a.w, b.w) };
+	}
+
+	VECMATH_INLINE vec4 max(const vec4& a, const vec4& b) 
+	{
+		return { std::fmax(a.x, b.x), std::fmax(a.y, b.y), std::fmax(a.z, b.z), std::fmax(a.w, b.w) };
+	}
+
+	VECMATH_INLINE quat slerp(const quat& a, const quat& b, float t) 
+	{
+		if (t <= 0)
+			return a;
+
+		quat c;
+		float d = dot(a, b);
+
+		if (d < 0) 
+		{
+			d = -d;
+			c = -b;
+		}
+		else 
+		{
+			c = b;
+		}
+
+		if (t >= 1)
+			return c;
+
+		//so we don't get a divide by zero error from sin(1)
+		if (d > 0.995f) 
+		{
+			return lerp(a, c, t);
+		}
+
+		float angle = std::acos(d);
+		return normalize((a * std::sin(angle * (1 - t)) + c * std::sin(angle * t)) * (1 / std::sin(angle)));
+	}
+
+	VECMATH_INLINE quat angle_axis(float angle, const vec3& axis) 
+	{
+		float a = angle * 0.5f;
+
+		quat result = 
+		{
+			axis * std::sin(a),
+			std::cos(a)
+		};
+
+		return normalize(result);
+	}
+
+	VECMATH_INLINE quat euler(const vec3& e) 
+	{
+		float hx = e.x * 0.5f;
+		float hy = e.y * 0.5f;
+		float hz = e.z * 0.5f;
+
+		float c1 = std::cos(hy);
+		float c2 = std::cos(hz);
+		float c3 = std::cos(hx);
+
+		float s1 = std::sin(hy);
+		float s2 = std::sin(hz);
+		float s3 = std::sin(hx);
+
+		quat result = 
+		{
+			s1 * s2 * c3 + c1 * c2 * s3,
+			s1 * c2 * c3 + c1 * s2 * s3,
+			c1 * s2 * c3 - s1 * c2 * s3,
+			c1 * c2 * c3 - s1 * s2 * s3
+		};
+
+		return normalize(result);
+	}
+}
+
+#endif
@@ -0,0 +1,5 @@
+#include <vecmath/aabb.hpp>
+
+#ifndef VECMATH_HEADER_ONLY
+#include <vecmath/aabb.inl>
+#endif
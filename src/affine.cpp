@@ -0,0 +1,5 @@
+#include <vecmath/affine.hpp>
+
+#ifndef VECMATH_HEADER_ONLY
+#include <vecmath/affine.inl>
+#endif
@@ -0,0 +1,236 @@
+#include <vecmath/animation.hpp>
+
+#include <algorithm>
+
+namespace vcm
+{
+	namespace
+	{
+		//tracks sampled per group by sample(t, cursors, out), few enough to gather their keys on the stack
+		const std::size_t sample_group = 64;
+
+		//the linear interpolation of each type
+		vec3 interpolate(const vec3& a, const vec3& b, float t)
+		{
+			return lerp(a, b, t);
+		}
+
+		quat interpolate(const quat& a, const quat& b, float t)
+		{
+			return slerp(a, b, t);
+		}
+
+		void interpolate(const vec3* a, const vec3* b, const float* t, vec3* out, std::size_t n, accuracy)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+				out[i] = lerp(a[i], b[i], t[i]);
+		}
+
+		void interpolate(const quat* a, const quat* b, const float* t, quat* out, std::size_t n, accuracy mode)
+		{
+			slerp_many(a, b, t, out, n, mode);
+		}
+
+		//the splines of quaternions are normalized back to rotations
+		vec3 spline_value(const vec3& v)
+		{
+			return v;
+		}
+
+		quat spline_value(const quat& q)
+		{
+			return normalize(q);
+		}
+
+		//negates the quaternion keys (and their tangents, if any) that aren't in the hemisphere of the key before them
+		void align(vec3*, vec3*, std::size_t) {}
+
+		void align(quat* keys, quat* tangents, std::size_t n)
+		{
+			for (std::size_t k = 1; k < n; ++k)
+			{
+				if (dot(keys[k - 1], keys[k]) >= 0)
+					continue;
+
+				keys[k] = -keys[k];
+
+				if (tangents)
+					tangents[k] = -tangents[k];
+			}
+		}
+	}
+
+	template <typename T>
+	keyframe_tracks<T>::keyframe_tracks() : end_time(0) {}
+
+	template <typename T>
+	std::size_t keyframe_tracks<T>::add(const float* times, const T* values, std::size_t n, interpolation mode, const T* tangents)
+	{
+		track tr = { (std::uint32_t)key_times.size(), (std::uint32_t)n, (std::uint32_t)key_tangents.size(), mode };
+
+		key_times.insert(key_times.end(), times, times + n);
+		key_values.insert(key_values.end(), values, values + n);
+
+		T* keys = key_values.data() + tr.first;
+
+		if (mode == interpolation::cubic && tangents)
+		{
+			key_tangents.insert(key_tangents.end(), tangents, tangents + n);
+			align(keys, key_tangents.data() + tr.tangents, n);
+		}
+		else
+		{
+			align(keys, nullptr, n);
+		}
+
+		if (mode == interpolation::catmull_rom || (mode == interpolation::cubic && !tangents))
+		{
+			//the slope between the neighbors of each key over their time (so uneven spacing doesn't overshoot),
+			//and the slope of the first or last segment at the ends
+			for (std::size_t k = 0; k < n; ++k)
+			{
+				std::size_t a = k > 0 ? k - 1 : 0;
+				std::size_t b = k + 1 < n ? k + 1 : n - 1;
+
+				key_tangents.push_back(a == b ? keys[k] * 0.0f : (keys[b] - keys[a]) * (1 / (times[b] - times[a])));
+			}
+		}
+
+		tracks.push_back(tr);
+		end_time = std::max(end_time, times[n - 1]);
+
+		return tracks.size() - 1;
+	}
+
+	template <typename T>
+	void keyframe_tracks<T>::clear()
+	{
+		tracks.clear();
+		key_times.clear();
+		key_values.clear();
+		key_tangents.clear();
+		end_time = 0;
+	}
+
+	template <typename T>
+	T keyframe_tracks<T>::sample(std::size_t i, float t) const
+	{
+		//a cursor past the last segment, which starts with a binary search
+		std::uint32_t cursor = (std::uint32_t)-1;
+		return sample(i, t, cursor);
+	}
+
+	template <typename T>
+	T keyframe_tracks<T>::sample(std::size_t i, float t, std::uint32_t& cursor) const
+	{
+		const track& tr = tracks[i];
+		const float* times = key_times.data() + tr.first;
+
+		//written so that nan holds the first key
+		if (!(t > times[0]))
+			return key_values[tr.first];
+
+		if (t >= times[tr.count - 1])
+			return key_values[tr.first + tr.count - 1];
+
+		cursor = find(tr, t, cursor);
+		return evaluate(tr, t, cursor);
+	}
+
+	template <typename T>
+	void keyframe_tracks<T>::sample(float t, std::uint32_t* cursors, T* out, accuracy mode) const
+	{
+		T a[sample_group], b[sample_group];
+		float factors[sample_group];
+		std::size_t index[sample_group];
+
+		for (std::size_t begin = 0; begin < tracks.size(); begin += sample_group)
+		{
+			std::size_t end = std::min(begin + sample_group, tracks.size());
+			std::size_t n = 0;
+
+			//gathers the segments of the linear tracks, and samples the others on the way
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const track& tr = tracks[i];
+				const float* times = key_times.data() + tr.first;
+
+				std::uint32_t cursor = cursors ? cursors[i] : (std::uint32_t)-1;
+
+				if (tr.mode == interpolation::linear && t > times[0] && t < times[tr.count - 1])
+				{
+					std::uint32_t k = find(tr, t, cursor);
+
+					a[n] = key_values[tr.first + k];
+					b[n] = key_values[tr.first + k + 1];
+					factors[n] = (t - times[k]) / (times[k + 1] - times[k]);
+					index[n++] = i;
+
+					cursor = k;
+				}
+				else
+				{
+					out[i] = sample(i, t, cursor);
+				}
+
+				if (cursors)
+					cursors[i] = cursor;
+			}
+
+			interpolate(a, b, factors, a, n, mode);
+
+			for (std::size_t j = 0; j < n; ++j)
+				out[index[j]] = a[j];
+		}
+	}
+
+	template <typename T>
+	std::uint32_t keyframe_tracks<T>::find(const track& tr, float t, std::uint32_t cursor) const
+	{
+		const float* times = key_times.data() + tr.first;
+		std::uint32_t last = tr.count - 1;
+
+		//playing forward stays in the segment of the cursor or moves on to the next one
+		if (cursor < last && times[cursor] <= t)
+		{
+			if (t < times[cursor + 1])
+				return cursor;
+
+			if (cursor + 2 <= last && t < times[cursor + 2])
+				return cursor + 1;
+		}
+
+		//the first key after 't' among the inner keys ends the segment
+		return (std::uint32_t)(std::upper_bound(times + 1, times + last, t) - times) - 1;
+	}
+
+	template <typename T>
+	T keyframe_tracks<T>::evaluate(const track& tr, float t, std::uint32_t k) const
+	{
+		const float* times = key_times.data() + tr.first + k;
+		const T* keys = key_values.data() + tr.first + k;
+
+		float dt = times[1] - times[0];
+		float u = (t - times[0]) / dt;
+
+		if (tr.mode == interpolation::step)
+			return keys[0];
+
+		if (tr.mode == interpolation::linear)
+			return interpolate(keys[0], keys[1], u);
+
+		//cubic hermite basis, with the tangents scaled from per unit of time to per segment
+		const T* tangents = key_tangents.data() + tr.tangents + k;
+
+		float u2 = u * u, u3 = u2 * u;
+		float h00 = 2 * u3 - 3 * u2 + 1;
+		float h10 = u3 - 2 * u2 + u;
+		float h01 = 3 * u2 - 2 * u3;
+		float h11 = u3 - u2;
+
+		return spline_value(keys[0] * h00 + tangents[0] * (h10 * dt) + keys[1] * h01 + tangents[1] * (h11 * dt));
+	}
+
+	template struct keyframe_tracks<vec3>;
+	template struct keyframe_tracks<quat>;
+}
@@ -0,0 +1,492 @@
+#include <vecmath/arrayfile.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(_WIN32)
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace vcm
+{
+	namespace
+	{
+		const char file_magic[8] = { 'V', 'C', 'M', 'A', 'R', 'R', 'A', 'Y' };
+		const std::uint32_t file_byte_order = 0x01020304;
+
+		const std::size_t min_alignment = 16;
+		const std::size_t max_alignment = 65536;
+
+		//elements encoded per chunk by the encoding writes
+		const std::size_t encode_chunk = 1024;
+
+		struct file_header
+		{
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t byte_order; //file_byte_order as written, which reads differently with the other byte order
+			std::uint32_t alignment;
+			std::uint32_t count;
+			std::uint64_t directory;
+			std::uint64_t size;
+			unsigned char reserved[24];
+		};
+
+		struct file_entry
+		{
+			char name[48]; //null terminated, zero padded
+			std::uint32_t type;
+			std::uint32_t encoding;
+			std::uint32_t stride;
+			std::uint32_t reserved0;
+			std::uint64_t count;
+			std::uint64_t offset;
+			std::uint64_t size;
+			std::uint64_t reserved1;
+		};
+
+		static_assert(sizeof(file_header) == 64, "the header must be 64 bytes");
+		static_assert(sizeof(file_entry) == 96, "directory entries must be 96 bytes");
+
+		//returns the bytes per element of 'type' stored as 'encoding', or 0 if the type can't be stored that way
+		std::size_t element_size(array_type type, array_encoding encoding)
+		{
+			switch (encoding)
+			{
+			case array_encoding::raw:
+				switch (type)
+				{
+				case array_type::f32: return sizeof(float);
+				case array_type::u16: return sizeof(std::uint16_t);
+				case array_type::u32: return sizeof(std::uint32_t);
+				case array_type::vec2: return sizeof(vec2);
+				case array_type::vec3: return sizeof(vec3);
+				case array_type::vec4: return sizeof(vec4);
+				case array_type::quat: return sizeof(quat);
+				case array_type::mat2: return sizeof(mat2);
+				case array_type::mat3: return sizeof(mat3);
+				case array_type::mat4: return sizeof(mat4);
+				case array_type::affine3: return sizeof(affine3);
+				case array_type::dualquat: return sizeof(dualquat);
+				case array_type::aabb: return sizeof(aabb);
+				}
+				return 0;
+			case array_encoding::half:
+				return type == array_type::vec3 ? sizeof(half3) : type == array_type::vec4 ? sizeof(half4) : 0;
+			case array_encoding::smallest_three:
+				return type == array_type::quat ? sizeof(packed_quat) : 0;
+			case array_encoding::snorm10:
+				return type == array_type::vec3 || type == array_type::vec4 ? sizeof(packed_normal) : 0;
+			}
+			return 0;
+		}
+
+		//returns whether the entry 'e' of a file of 'length' bytes with arrays aligned to 'alignment' is valid
+		bool valid_entry(const file_entry& e, std::uint64_t length, std::uint64_t alignment)
+		{
+			if (e.name[0] == 0 || e.name[sizeof(e.name) - 1] != 0)
+				return false;
+
+			std::size_t stride = element_size((array_type)e.type, (array_encoding)e.encoding);
+
+			if (stride == 0 || e.stride != stride || e.count > e.size / stride || e.size != e.count * stride)
+				return false;
+
+			return e.offset >= sizeof(file_header) && e.offset % alignment == 0 && e.offset <= length && e.size <= length - e.offset;
+		}
+	}
+
+	//ARRAY_WRITER
+
+	array_writer::array_writer() : file(nullptr), position(0), alignment(0), failed(false) {}
+
+	array_writer::~array_writer()
+	{
+		close();
+	}
+
+	bool array_writer::open(const char* path, std::size_t alignment)
+	{
+		close();
+
+		if (alignment < min_alignment || alignment > max_alignment || (alignment & (alignment - 1)) != 0)
+			return false;
+
+		file = std::fopen(path, "wb");
+
+		if (!file)
+			return false;
+
+		this->alignment = alignment;
+		position = 0;
+		directory.clear();
+		failed = false;
+
+		//the header is written by close(), once the directory is known
+		file_header header = {};
+		return write_bytes(&header, sizeof(header));
+	}
+
+	bool array_writer::write(const char* name, const vec3* data, std::size_t n, array_encoding encoding)
+	{
+		switch (encoding)
+		{
+		case array_encoding::raw: return write(name, data, n);
+		case array_encoding::half: return begin_array(name, array_type::vec3, encoding, n) && write_encoded<vec3, half3>(data, n, pack_halves);
+		case array_encoding::snorm10: return begin_array(name, array_type::vec3, encoding, n) && write_encoded<vec3, packed_normal>(data, n, pack_normals);
+		default: return false;
+		}
+	}
+
+	bool array_writer::write(const char* name, const vec4* data, std::size_t n, array_encoding encoding)
+	{
+		switch (encoding)
+		{
+		case array_encoding::raw: return write(name, data, n);
+		case array_encoding::half: return begin_array(name, array_type::vec4, encoding, n) && write_encoded<vec4, half4>(data, n, pack_halves);
+		case array_encoding::snorm10: return begin_array(name, array_type::vec4, encoding, n) && write_encoded<vec4, packed_normal>(data, n, pack_normals);
+		default: return false;
+		}
+	}
+
+	bool array_writer::write(const char* name, const quat* data, std::size_t n, array_encoding encoding)
+	{
+		switch (encoding)
+		{
+		case array_encoding::raw: return write(name, data, n);
+		case array_encoding::smallest_three: return begin_array(name, array_type::quat, encoding, n) && write_encoded<quat, packed_quat>(data, n, pack_quats);
+		default: return false;
+		}
+	}
+
+	bool array_writer::close()
+	{
+		if (!file)
+			return false;
+
+		pad();
+		std::uint64_t start = position;
+
+		if (!directory.empty())
+			write_bytes(directory.data(), directory.size());
+
+		file_header header = {};
+		std::memcpy(header.magic, file_magic, sizeof(file_magic));
+		header.version = version;
+		header.byte_order = file_byte_order;
+		header.alignment = (std::uint32_t)alignment;
+		header.count = (std::uint32_t)(directory.size() / sizeof(file_entry));
+		header.directory = start;
+		header.size = position;
+
+		if (std::fseek(file, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, file) != 1)
+			failed = true;
+
+		if (std::fclose(file) != 0)
+			failed = true;
+
+		file = nullptr;
+		return !failed;
+	}
+
+	bool array_writer::write_array(const char* name, array_type type, array_encoding encoding, const void* data, std::size_t n)
+	{
+		return begin_array(name, type, encoding, n) && write_bytes(data, n * element_size(type, encoding));
+	}
+
+	bool array_writer::begin_array(const char* name, array_type type, array_encoding encoding, std::size_t n)
+	{
+		std::size_t stride = element_size(type, encoding);
+		std::size_t name_length = std::strlen(name);
+
+		if (!file || failed || stride == 0 || name_length == 0 || name_length >= sizeof(file_entry::name))
+			return false;
+
+		for (std::size_t i = 0; i < directory.size(); i += sizeof(file_entry))
+		{
+			if (std::strcmp((const char*)&directory[i], name) == 0)
+				return false;
+		}
+
+		if (!pad())
+			return false;
+
+		file_entry e = {};
+		std::memcpy(e.name, name, name_length);
+		e.type = (std::uint32_t)type;
+		e.encoding = (std::uint32_t)encoding;
+		e.stride = (std::uint32_t)stride;
+		e.count = n;
+		e.offset = position;
+		e.size = (std::uint64_t)n * stride;
+
+		const unsigned char* bytes = (const unsigned char*)&e;
+		directory.insert(directory.end(), bytes, bytes + sizeof(e));
+
+		return true;
+	}
+
+	template <typename In, typename Out>
+	bool array_writer::write_encoded(const In* data, std::size_t n, void (*encode)(const In*, Out*, std::size_t))
+	{
+		Out buffer[encode_chunk];
+
+		for (std::size_t i = 0; i < n; i += encode_chunk)
+		{
+			std::size_t count = std::min(encode_chunk, n - i);
+			encode(data + i, buffer, count);
+
+			if (!write_bytes(buffer, count * sizeof(Out)))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool array_writer::pad()
+	{
+		static const unsigned char zeros[64] = {};
+		std::uint64_t start = (position + alignment - 1) / alignment * alignment;
+
+		while (position < start)
+		{
+			if (!write_bytes(zeros, (std::size_t)std::min<std::uint64_t>(sizeof(zeros), start - position)))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool array_writer::write_bytes(const void* data, std::size_t size)
+	{
+		if (failed)
+			return false;
+
+		if (size != 0 && std::fwrite(data, 1, size, file) != size)
+		{
+			failed = true;
+			return false;
+		}
+
+		position += size;
+		return true;
+	}
+
+	//ARRAY_FILE
+
+	array_file::array_file() : base(nullptr), length(0), handle(nullptr) {}
+
+	array_file::~array_file()
+	{
+		close();
+	}
+
+	bool array_file::open(const char* path)
+	{
+		close();
+
+		std::uint64_t size = 0;
+		void* view = nullptr;
+
+#if defined(_WIN32)
+		HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (f == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER file_size;
+
+		if (!GetFileSizeEx(f, &file_size) || file_size.QuadPart < (LONGLONG)sizeof(file_header))
+		{
+			CloseHandle(f);
+			return false;
+		}
+
+		HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(f);
+
+		if (!m)
+			return false;
+
+		size = (std::uint64_t)file_size.QuadPart;
+		view = size <= std::numeric_limits<std::size_t>::max() ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+		if (!view)
+		{
+			CloseHandle(m);
+			return false;
+		}
+
+		handle = m;
+#else
+		int fd = ::open(path, O_RDONLY);
+
+		if (fd < 0)
+			return false;
+
+		struct stat st;
+
+		if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(file_header) || (std::uint64_t)st.st_size > std::numeric_limits<std::size_t>::max())
+		{
+			::close(fd);
+			return false;
+		}
+
+		size = (std::uint64_t)st.st_size;
+
+		//the mapping keeps the file open
+		view = mmap(nullptr, (std::size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+
+		if (view == MAP_FAILED)
+			return false;
+#endif
+
+		base = (const unsigned char*)view;
+		length = (std::size_t)size;
+
+		//the header and the entries are copied out, since the directory offset of a corrupt file may be misaligned
+		file_header header;
+		std::memcpy(&header, base, sizeof(header));
+
+		bool valid = std::memcmp(header.magic, file_magic, sizeof(file_magic)) == 0 && header.byte_order == file_byte_order
+			&& header.version >> 16 == array_writer::version >> 16 && header.size == size
+			&& header.alignment >= min_alignment && header.alignment <= max_alignment && (header.alignment & (header.alignment - 1)) == 0
+			&& header.directory >= sizeof(file_header) && header.directory <= size && header.count <= (size - header.directory) / sizeof(file_entry);
+
+		for (std::uint32_t i = 0; valid && i < header.count; ++i)
+		{
+			const unsigned char* p = base + header.directory + i * sizeof(file_entry);
+
+			file_entry e;
+			std::memcpy(&e, p, sizeof(e));
+
+			if (!valid_entry(e, header.directory, header.alignment))
+			{
+				valid = false;
+				break;
+			}
+
+			array_info info = { (const char*)p, (array_type)e.type, (array_encoding)e.encoding, (std::size_t)e.count, e.stride, e.offset };
+			arrays.push_back(info);
+		}
+
+		if (!valid)
+			close();
+
+		return valid;
+	}
+
+	void array_file::close()
+	{
+		if (base)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(base);
+			CloseHandle((HANDLE)handle);
+#else
+			munmap((void*)base, length);
+#endif
+		}
+
+		base = nullptr;
+		length = 0;
+		handle = nullptr;
+		arrays.clear();
+	}
+
+	const array_info* array_file::find(const char* name) const
+	{
+		for (const array_info& info : arrays)
+		{
+			if (std::strcmp(info.name, name) == 0)
+				return &info;
+		}
+
+		return nullptr;
+	}
+
+	void array_file::prefetch(const char* name) const
+	{
+		const array_info* info = find(name);
+
+		if (!info || info->count == 0)
+			return;
+
+#if defined(_WIN32)
+		//PrefetchVirtualMemory needs windows 8; the pages are read on first access instead
+#else
+		//madvise() takes a page aligned address
+		std::size_t page = (std::size_t)sysconf(_SC_PAGESIZE);
+		std::size_t begin = (std::size_t)info->offset / page * page;
+		std::size_t end = (std::size_t)info->offset + info->count * info->stride;
+
+		madvise((void*)(base + begin), end - begin, MADV_WILLNEED);
+#endif
+	}
+
+	const void* array_file::find_data(const char* name, array_type type, array_encoding encoding, std::size_t stride, std::size_t& count) const
+	{
+		const array_info* info = find(name);
+
+		if (!info || info->encoding != encoding || info->stride != stride)
+			return nullptr;
+
+		//the snorm10 encoding stores vec3 and vec4 arrays alike
+		bool vector = info->type == array_type::vec3 || info->type == array_type::vec4;
+
+		if (info->type != type && !(encoding == array_encoding::snorm10 && vector))
+			return nullptr;
+
+		count = info->count;
+		return count ? base + info->offset : nullptr;
+	}
+
+	bool array_file::read_array(const char* name, array_type type, void* out) const
+	{
+		const array_info* info = find(name);
+
+		if (!info || info->type != type)
+			return false;
+
+		const void* data = base + info->offset;
+		std::size_t n = info->count;
+
+		switch (info->encoding)
+		{
+		case array_encoding::raw:
+			if (n != 0)
+				std::memcpy(out, data, n * info->stride);
+			return true;
+		case array_encoding::half:
+			if (type == array_type::vec3)
+				unpack_halves((const half3*)data, (vec3*)out, n);
+			else
+				unpack_halves((const half4*)data, (vec4*)out, n);
+			return true;
+		case array_encoding::smallest_three:
+			unpack_quats((const packed_quat*)data, (quat*)out, n);
+			return true;
+		case array_encoding::snorm10:
+			if (type == array_type::vec3)
+				unpack_normals((const packed_normal*)data, (vec3*)out, n);
+			else
+				unpack_normals((const packed_normal*)data, (vec4*)out, n);
+			return true;
+		}
+
+		return false;
+	}
+}
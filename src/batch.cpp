@@ -0,0 +1,171 @@
+#include <vecmath/batch.hpp>
+
+#include "kernels.hpp"
+#include "parallel.hpp"
+
+namespace vcm
+{
+	namespace
+	{
+		//transforms per thread below which compose_many doesn't start more threads
+		const std::size_t compose_grain = 4096;
+	}
+
+	void transform_points(const mat4& m, const vec3* in, vec3* out, std::size_t n)
+	{
+		kernels().transform_points(m, in, out, n);
+	}
+
+	void transform_points(const mat4& m, vec3* points, std::size_t n)
+	{
+		kernels().transform_points(m, points, points, n);
+	}
+
+	void transform_vectors(const mat4& m, const vec3* in, vec3* out, std::size_t n)
+	{
+		kernels().transform_vectors(m, in, out, n);
+	}
+
+	void transform_vectors(const mat4& m, vec3* vectors, std::size_t n)
+	{
+		kernels().transform_vectors(m, vectors, vectors, n);
+	}
+
+	void transform_points(const affine3& a, const vec3* in, vec3* out, std::size_t n)
+	{
+		kernels().transform_points(mat4(a), in, out, n);
+	}
+
+	void transform_points(const affine3& a, vec3* points, std::size_t n)
+	{
+		kernels().transform_points(mat4(a), points, points, n);
+	}
+
+	void transform_vectors(const affine3& a, const vec3* in, vec3* out, std::size_t n)
+	{
+		kernels().transform_vectors(mat4(a), in, out, n);
+	}
+
+	void transform_vectors(const affine3& a, vec3* vectors, std::size_t n)
+	{
+		kernels().transform_vectors(mat4(a), vectors, vectors, n);
+	}
+
+	void transform_aabbs(const mat4& m, const aabb* in, aabb* out, std::size_t n)
+	{
+		kernels().transform_aabbs(m, in, out, n);
+	}
+
+	void transform_aabbs(const mat4& m, aabb* boxes, std::size_t n)
+	{
+		kernels().transform_aabbs(m, boxes, boxes, n);
+	}
+
+	void transform_aabbs(const affine3& a, const aabb* in, aabb* out, std::size_t n)
+	{
+		kernels().transform_aabbs(mat4(a), in, out, n);
+	}
+
+	void transform_aabbs(const affine3& a, aabb* boxes, std::size_t n)
+	{
+		kernels().transform_aabbs(mat4(a), boxes, boxes, n);
+	}
+
+	void multiply_many(const mat4* a, const mat4* b, mat4* out, std::size_t n)
+	{
+		kernels().multiply(a, b, out, n);
+	}
+
+	void normal_matrices(const mat4* in, mat3* out, std::size_t n, normal_scale scale)
+	{
+		kernels().normal_matrices((const float*)in, 4, (float*)out, 3, n, scale);
+	}
+
+	void normal_matrices(const affine3* in, mat3* out, std::size_t n, normal_scale scale)
+	{
+		kernels().normal_matrices((const float*)in, 3, (float*)out, 3, n, scale);
+	}
+
+	void normal_matrices(const mat4* in, vec4* out, std::size_t n, normal_scale scale)
+	{
+		kernels().normal_matrices((const float*)in, 4, (float*)out, 4, n, scale);
+	}
+
+	void normal_matrices(const affine3* in, vec4* out, std::size_t n, normal_scale scale)
+	{
+		kernels().normal_matrices((const float*)in, 3, (float*)out, 4, n, scale);
+	}
+
+	void rotate_many(const quat* q, const vec3* in, vec3* out, std::size_t n)
+	{
+		kernels().rotate(q, in, out, n, false);
+	}
+
+	void inverse_rotate_many(const quat* q, const vec3* in, vec3* out, std::size_t n)
+	{
+		kernels().rotate(q, in, out, n, true);
+	}
+
+	void rotate_many(const quat& q, const vec3* in, vec3* out, std::size_t n)
+	{
+		//the rotated axes are the columns of the rotation matrix, without the normalize of mat3(q)
+		mat4 m(mat3(rotate(q, vec3(1, 0, 0)), rotate(q, vec3(0, 1, 0)), rotate(q, vec3(0, 0, 1))));
+		kernels().transform_vectors(m, in, out, n);
+	}
+
+	void compose_many(const vec3* tran, const quat* rot, const vec3* scale, mat4* out, std::size_t n, unsigned threads)
+	{
+		const kernel_table& k = kernels();
+
+		parallel::for_ranges(n, threads, compose_grain, [=, &k](std::size_t begin, std::size_t end)
+		{
+			k.compose(tran, rot, scale, out, begin, end);
+		});
+	}
+
+	void compose_many(const vec3_soa& tran, const quat_soa& rot, const vec3_soa& scale, mat4* out, unsigned threads)
+	{
+		const kernel_table& k = kernels();
+
+		parallel::for_ranges(tran.size(), threads, compose_grain, [&](std::size_t begin, std::size_t end)
+		{
+			k.compose_soa(tran, rot, scale, out, begin, end);
+		});
+	}
+
+	void slerp_many(const quat* a, const quat* b, float t, quat* out, std::size_t n, accuracy mode)
+	{
+		if (mode == accuracy::exact)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+				out[i] = slerp(a[i], b[i], t);
+
+			return;
+		}
+
+		kernels().slerp(a, b, t, out, n);
+	}
+
+	void slerp_many(const quat* a, const quat* b, const float* t, quat* out, std::size_t n, accuracy mode)
+	{
+		if (mode == accuracy::exact)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+				out[i] = slerp(a[i], b[i], t[i]);
+
+			return;
+		}
+
+		kernels().slerp_array(a, b, t, out, n);
+	}
+
+	void nlerp_many(const quat* a, const quat* b, float t, quat* out, std::size_t n)
+	{
+		kernels().nlerp(a, b, t, out, n);
+	}
+
+	void nlerp_many(const quat* a, const quat* b, const float* t, quat* out, std::size_t n)
+	{
+		kernels().nlerp_array(a, b, t, out, n);
+	}
+}
@@ -0,0 +1,566 @@
+#include <vecmath/bvh.hpp>
+
+#include "kernels.hpp"
+#include "task_pool.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace vcm
+{
+	static_assert(sizeof(bvh_node) == 32, "bvh nodes must be 32 bytes");
+
+	const std::uint32_t ray_hit::none;
+	const unsigned bvh::max_depth;
+
+	namespace
+	{
+		//centroid bins per axis when searching for a split
+		const unsigned bin_count = 16;
+
+		//leaves hold at most this many primitives, unless they can't be split
+		const std::uint32_t max_leaf = 8;
+
+		//from this depth on, nodes are split at their median instead of by the surface area heuristic,
+		//so fewer than 2^32 primitives stay within bvh::max_depth levels
+		const unsigned median_depth = bvh::max_depth - 32;
+
+		//a depth first traversal holds at most one sibling per level, plus the two children just pushed
+		const unsigned stack_size = bvh::max_depth + 2;
+
+		//subtrees of at least this many primitives are built as tasks of their own
+		const std::uint32_t subtree_grain = 4096;
+
+		//grows the box from 'min' to 'max' to hold the box from 'lo' to 'hi'; written out rather than with
+		//vcm::min and vcm::max, which aren't inlined outside header-only builds and dominate the binning
+		void grow(vec3& min, vec3& max, const vec3& lo, const vec3& hi)
+		{
+			min = vec3(std::min(min.x, lo.x), std::min(min.y, lo.y), std::min(min.z, lo.z));
+			max = vec3(std::max(max.x, hi.x), std::max(max.y, hi.y), std::max(max.z, hi.z));
+		}
+
+		float half_area(const aabb& b)
+		{
+			vec3 e = b.max - b.min;
+			return e.x * e.y + e.y * e.z + e.z * e.x;
+		}
+
+		//the reciprocal of 'd', with zero components replaced by a tiny value so that (min - origin) * inverse
+		//never becomes 0 * infinity
+		vec3 inverse_direction(const vec3& d)
+		{
+			return vec3(1.0f / (d.x != 0 ? d.x : 1e-30f), 1.0f / (d.y != 0 ? d.y : 1e-30f), 1.0f / (d.z != 0 ? d.z : 1e-30f));
+		}
+
+		//returns the distance where the ray from 'origin' with the inverse direction 'inv' enters the box from 'min'
+		//to 'max', or infinity if it misses it between 0 and 'length'
+		float enter(const vec3& min, const vec3& max, const vec3& origin, const vec3& inv, float length)
+		{
+			vec3 t0 = (min - origin) * inv;
+			vec3 t1 = (max - origin) * inv;
+
+			float near = std::max(std::max(std::min(t0.x, t1.x), std::min(t0.y, t1.y)), std::max(std::min(t0.z, t1.z), 0.0f));
+			float far = std::min(std::min(std::max(t0.x, t1.x), std::max(t0.y, t1.y)), std::min(std::max(t0.z, t1.z), length));
+
+			return near <= far ? near : std::numeric_limits<float>::infinity();
+		}
+
+		//subtree left for a task: the node at 'node' over order[begin, end)
+		struct subtree
+		{
+			std::uint32_t node;
+			std::uint32_t begin;
+			std::uint32_t end;
+			unsigned depth;
+		};
+
+		struct builder
+		{
+			const std::vector<aabb>& prims;
+			const std::vector<vec3>& centers;
+			std::vector<std::uint32_t>& order;
+
+			//splits order[begin, end) in two and returns where the second half starts, or 'begin' for a leaf;
+			//writes the box around the range to 'box'
+			std::uint32_t split(std::uint32_t begin, std::uint32_t end, unsigned depth, aabb& box) const
+			{
+				aabb bounds;
+				vec3 cmin = centers[order[begin]], cmax = cmin;
+
+				for (std::uint32_t i = begin; i < end; ++i)
+				{
+					const aabb& b = prims[order[i]];
+					grow(bounds.min, bounds.max, b.min, b.max);
+					grow(cmin, cmax, centers[order[i]], centers[order[i]]);
+				}
+
+				box = bounds;
+
+				std::uint32_t count = end - begin;
+				if (count == 1)
+					return begin;
+
+				//the axis with the widest spread of centroids
+				vec3 spread = cmax - cmin;
+				unsigned widest = spread.x >= spread.y && spread.x >= spread.z ? 0 : spread.y >= spread.z ? 1 : 2;
+
+				if (depth >= median_depth || spread[widest] == 0)
+				{
+					if (count <= max_leaf)
+						return begin;
+
+					std::uint32_t mid = begin + count / 2;
+
+					if (spread[widest] != 0)
+					{
+						std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](std::uint32_t a, std::uint32_t b)
+						{
+							return centers[a][widest] < centers[b][widest];
+						});
+					}
+
+					return mid;
+				}
+
+				//cost of each split, as half areas times primitive counts, for the splits after each bin
+				//small nodes get fewer bins, which is as good as one bin per primitive and saves sweeping empty ones
+				unsigned bins_used = std::min(bin_count, (unsigned)count);
+				float best_cost = std::numeric_limits<float>::infinity();
+				unsigned best_axis = 0, best_bin = 0;
+
+				for (unsigned axis = 0; axis < 3; ++axis)
+				{
+					if (spread[axis] == 0)
+						continue;
+
+					float scale = bins_used / spread[axis];
+
+					aabb bins[bin_count];
+					std::uint32_t counts[bin_count] = {};
+
+					for (std::uint32_t i = begin; i < end; ++i)
+					{
+						unsigned bin = std::min(bins_used - 1, (unsigned)((centers[order[i]][axis] - cmin[axis]) * scale));
+						const aabb& b = prims[order[i]];
+
+						grow(bins[bin].min, bins[bin].max, b.min, b.max);
+						++counts[bin];
+					}
+
+					//sweep from the right, then from the left, pricing each split
+					float right_cost[bin_count];
+					aabb right;
+					std::uint32_t right_count = 0;
+
+					for (unsigned bin = bins_used - 1; bin > 0; --bin)
+					{
+						grow(right.min, right.max, bins[bin].min, bins[bin].max);
+						right_count += counts[bin];
+
+						right_cost[bin] = right_count == 0 ? 0 : half_area(right) * right_count;
+					}
+
+					aabb left;
+					std::uint32_t left_count = 0;
+
+					for (unsigned bin = 0; bin + 1 < bins_used; ++bin)
+					{
+						grow(left.min, left.max, bins[bin].min, bins[bin].max);
+						left_count += counts[bin];
+
+						if (left_count == 0 || left_count == count)
+							continue;
+
+						float cost = half_area(left) * left_count + right_cost[bin + 1];
+
+						if (cost < best_cost)
+						{
+							best_cost = cost;
+							best_axis = axis;
+							best_bin = bin;
+						}
+					}
+				}
+
+				//a leaf costs one intersection per primitive, a split one box test plus the children
+				//weighted by the chance of hitting them
+				float area = half_area(bounds);
+
+				if (count <= max_leaf && (area == 0 || 1 + best_cost / area >= count))
+					return begin;
+
+				float scale = bins_used / spread[best_axis];
+				float low = cmin[best_axis];
+
+				std::uint32_t* mid = std::partition(order.data() + begin, order.data() + end, [&](std::uint32_t p)
+				{
+					return std::min(bins_used - 1, (unsigned)((centers[p][best_axis] - low) * scale)) <= best_bin;
+				});
+
+				return (std::uint32_t)(mid - order.data());
+			}
+
+			//builds the subtree over order[begin, end) into 'nodes' at 'node', which is already allocated
+			//with 'tasks', subtrees of up to 'task_size' primitives are left to tasks instead
+			void build(std::vector<bvh_node>& nodes, std::uint32_t node, std::uint32_t begin, std::uint32_t end, unsigned depth, std::vector<subtree>* tasks, std::uint32_t task_size) const
+			{
+				if (tasks && end - begin <= task_size)
+				{
+					tasks->push_back({ node, begin, end, depth });
+					return;
+				}
+
+				aabb box;
+				std::uint32_t mid = split(begin, end, depth, box);
+
+				nodes[node].min = box.min;
+				nodes[node].max = box.max;
+
+				if (mid == begin)
+				{
+					nodes[node].first = begin;
+					nodes[node].count = end - begin;
+					return;
+				}
+
+				std::uint32_t child = (std::uint32_t)nodes.size();
+				nodes.resize(child + 2);
+
+				nodes[node].first = child;
+				nodes[node].count = 0;
+
+				build(nodes, child, begin, mid, depth + 1, tasks, task_size);
+				build(nodes, child + 1, mid, end, depth + 1, tasks, task_size);
+			}
+		};
+	}
+
+	bool intersect(const ray& r, const vec3& a, const vec3& b, const vec3& c, float& t, float& u, float& v)
+	{
+		//moller-trumbore: solves origin + t * direction = a + u * (b - a) + v * (c - a) with cramer's rule
+		vec3 e1 = b - a;
+		vec3 e2 = c - a;
+		vec3 p = cross(r.direction, e2);
+
+		float det = dot(e1, p);
+		if (det == 0)
+			return false;
+
+		float inv = 1.0f / det;
+		vec3 s = r.origin - a;
+
+		float hu = dot(s, p) * inv;
+		if (hu < 0 || hu > 1)
+			return false;
+
+		vec3 q = cross(s, e1);
+
+		float hv = dot(r.direction, q) * inv;
+		if (hv < 0 || hu + hv > 1)
+			return false;
+
+		float ht = dot(e2, q) * inv;
+		if (ht < 0 || ht > r.length)
+			return false;
+
+		t = ht;
+		u = hu;
+		v = hv;
+
+		return true;
+	}
+
+	bool intersect(const ray& r, const aabb& box, float& t)
+	{
+		float near = enter(box.min, box.max, r.origin, inverse_direction(r.direction), r.length);
+		if (near == std::numeric_limits<float>::infinity())
+			return false;
+
+		t = near;
+		return true;
+	}
+
+	bvh::bvh() {}
+
+	void bvh::build(const aabb* boxes, std::size_t n, unsigned threads)
+	{
+		std::vector<aabb> prims(boxes, boxes + n);
+		build_tree(prims, threads);
+
+		leaf_triangles.clear();
+		leaf_boxes.resize(n);
+
+		for (std::size_t i = 0; i < n; ++i)
+			leaf_boxes[i] = boxes[order[i]];
+	}
+
+	void bvh::build(const vec3* vertices, const std::uint32_t* indices, std::size_t n, unsigned threads)
+	{
+		leaf_triangles.resize(3 * n);
+
+		for (std::size_t i = 0; i < 3 * n; ++i)
+			leaf_triangles[i] = vertices[indices ? indices[i] : i];
+
+		std::vector<aabb> prims(n);
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const vec3* v = &leaf_triangles[3 * i];
+			prims[i] = aabb(min(min(v[0], v[1]), v[2]), max(max(v[0], v[1]), v[2]));
+		}
+
+		build_tree(prims, threads);
+
+		//reorder the triangles to leaf order
+		std::vector<vec3> sorted(3 * n);
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			sorted[3 * i] = leaf_triangles[3 * order[i]];
+			sorted[3 * i + 1] = leaf_triangles[3 * order[i] + 1];
+			sorted[3 * i + 2] = leaf_triangles[3 * order[i] + 2];
+		}
+
+		leaf_triangles.swap(sorted);
+		leaf_boxes.clear();
+	}
+
+	void bvh::build_tree(const std::vector<aabb>& prims, unsigned threads)
+	{
+		std::uint32_t n = (std::uint32_t)prims.size();
+
+		tree.clear();
+		order.resize(n);
+
+		if (n == 0)
+			return;
+
+		std::vector<vec3> centers(n);
+
+		for (std::uint32_t i = 0; i < n; ++i)
+		{
+			centers[i] = center(prims[i]);
+			order[i] = i;
+		}
+
+		builder b = { prims, centers, order };
+		tree.resize(1);
+
+		task_pool pool(threads);
+
+		if (pool.size() == 1 || n < 2 * subtree_grain)
+		{
+			b.build(tree, 0, 0, n, 0, nullptr, 0);
+			return;
+		}
+
+		//the top of the tree is split on this thread until the subtrees are small enough to balance
+		//across the pool, then each subtree is built into its own array and appended
+		std::uint32_t task_size = std::max(subtree_grain, n / (4 * pool.size()));
+		std::vector<subtree> tasks;
+
+		b.build(tree, 0, 0, n, 0, &tasks, task_size);
+
+		std::vector<std::vector<bvh_node>> subtrees(tasks.size());
+
+		pool.run(tasks.size(), [&](std::size_t t)
+		{
+			subtrees[t].resize(1);
+			b.build(subtrees[t], 0, tasks[t].begin, tasks[t].end, tasks[t].depth, nullptr, 0);
+		});
+
+		for (std::size_t t = 0; t < tasks.size(); ++t)
+		{
+			const std::vector<bvh_node>& nodes = subtrees[t];
+
+			//node j > 0 of the subtree moves to base + j - 1; its root replaces the placeholder
+			std::uint32_t base = (std::uint32_t)tree.size();
+
+			for (std::size_t j = 0; j < nodes.size(); ++j)
+			{
+				bvh_node node = nodes[j];
+
+				if (node.count == 0)
+					node.first = base + node.first - 1;
+
+				if (j == 0)
+					tree[tasks[t].node] = node;
+				else
+					tree.push_back(node);
+			}
+		}
+	}
+
+	bool bvh::intersect(const ray& r, ray_hit& hit) const
+	{
+		hit.t = r.length;
+		hit.u = hit.v = 0;
+		hit.index = ray_hit::none;
+
+		if (tree.empty())
+			return false;
+
+		vec3 inv = inverse_direction(r.direction);
+
+		//nodes still to visit, with the distance where the ray enters them
+		std::uint32_t stack[stack_size];
+		float entry[stack_size];
+		unsigned top = 0;
+
+		float root = enter(tree[0].min, tree[0].max, r.origin, inv, hit.t);
+		if (root == std::numeric_limits<float>::infinity())
+			return false;
+
+		stack[top] = 0;
+		entry[top++] = root;
+
+		while (top > 0)
+		{
+			--top;
+
+			//boxes entered beyond the closest hit so far can't hold a closer one
+			if (entry[top] > hit.t)
+				continue;
+
+			const bvh_node& node = tree[stack[top]];
+
+			if (node.count > 0)
+			{
+				for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+				{
+					float t, u = 0, v = 0;
+					bool found;
+
+					if (leaf_boxes.empty())
+						found = vcm::intersect(ray(r.origin, r.direction, hit.t), leaf_triangles[3 * i], leaf_triangles[3 * i + 1], leaf_triangles[3 * i + 2], t, u, v);
+					else
+						found = (t = enter(leaf_boxes[i].min, leaf_boxes[i].max, r.origin, inv, hit.t)) != std::numeric_limits<float>::infinity();
+
+					if (found && (t < hit.t || hit.index == ray_hit::none))
+					{
+						hit.t = t;
+						hit.u = u;
+						hit.v = v;
+						hit.index = order[i];
+					}
+				}
+
+				continue;
+			}
+
+			const bvh_node& a = tree[node.first];
+			const bvh_node& b = tree[node.first + 1];
+
+			float ta = enter(a.min, a.max, r.origin, inv, hit.t);
+			float tb = enter(b.min, b.max, r.origin, inv, hit.t);
+
+			std::uint32_t na = node.first, nb = node.first + 1;
+
+			if (ta > tb)
+			{
+				std::swap(ta, tb);
+				std::swap(na, nb);
+			}
+
+			//the nearer child is pushed last, so it is visited first
+			if (tb != std::numeric_limits<float>::infinity())
+			{
+				stack[top] = nb;
+				entry[top++] = tb;
+			}
+
+			if (ta != std::numeric_limits<float>::infinity())
+			{
+				stack[top] = na;
+				entry[top++] = ta;
+			}
+		}
+
+		return hit.index != ray_hit::none;
+	}
+
+	bool bvh::occluded(const ray& r) const
+	{
+		if (tree.empty())
+			return false;
+
+		vec3 inv = inverse_direction(r.direction);
+
+		std::uint32_t stack[stack_size];
+		unsigned top = 0;
+
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const bvh_node& node = tree[stack[--top]];
+
+			if (enter(node.min, node.max, r.origin, inv, r.length) == std::numeric_limits<float>::infinity())
+				continue;
+
+			if (node.count == 0)
+			{
+				stack[top++] = node.first;
+				stack[top++] = node.first + 1;
+				continue;
+			}
+
+			for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+			{
+				float t, u, v;
+
+				if (leaf_boxes.empty() ? vcm::intersect(r, leaf_triangles[3 * i], leaf_triangles[3 * i + 1], leaf_triangles[3 * i + 2], t, u, v)
+					: enter(leaf_boxes[i].min, leaf_boxes[i].max, r.origin, inv, r.length) != std::numeric_limits<float>::infinity())
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	void bvh::intersect(const ray* rays, ray_hit* hits, std::size_t n) const
+	{
+		kernels().intersect_rays(*this, rays, hits, n);
+	}
+
+	void bvh::occluded(const ray* rays, std::uint32_t* mask, std::size_t n) const
+	{
+		std::memset(mask, 0, (n + 31) / 32 * sizeof(std::uint32_t));
+		kernels().occluded_rays(*this, rays, mask, n);
+	}
+
+	void bvh::overlap(const aabb& box, std::vector<std::uint32_t>& out) const
+	{
+		if (tree.empty())
+			return;
+
+		std::uint32_t stack[stack_size];
+		unsigned top = 0;
+
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const bvh_node& node = tree[stack[--top]];
+
+			if (!overlaps(aabb(node.min, node.max), box))
+				continue;
+
+			if (node.count == 0)
+			{
+				stack[top++] = node.first;
+				stack[top++] = node.first + 1;
+				continue;
+			}
+
+			for (std::uint32_t i = node.first; i < node.first + node.count; ++i)
+			{
+				aabb b = leaf_boxes.empty() ? aabb(min(min(leaf_triangles[3 * i], leaf_triangles[3 * i + 1]), leaf_triangles[3 * i + 2]),
+					max(max(leaf_triangles[3 * i], leaf_triangles[3 * i + 1]), leaf_triangles[3 * i + 2])) : leaf_boxes[i];
+
+				if (overlaps(b, box))
+					out.push_back(order[i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,180 @@
+#include <vecmath/backend.hpp>
+
+#include "kernels.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(VECMATH_KERNELS_SSE2) || defined(VECMATH_KERNELS_AVX2)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace vcm
+{
+	namespace
+	{
+#if defined(VECMATH_KERNELS_SSE2) || defined(VECMATH_KERNELS_AVX2)
+		//returns the registers eax, ebx, ecx, and edx of cpuid leaf 'leaf', subleaf 0
+		void cpuid(unsigned leaf, unsigned r[4])
+		{
+#if defined(_MSC_VER)
+			int regs[4];
+			__cpuidex(regs, (int)leaf, 0);
+
+			for (unsigned i = 0; i < 4; ++i)
+				r[i] = (unsigned)regs[i];
+#else
+			r[0] = r[1] = r[2] = r[3] = 0;
+			__get_cpuid_count(leaf, 0, &r[0], &r[1], &r[2], &r[3]);
+#endif
+		}
+
+		//returns the low half of the extended control register 0, which tells the state the os saves
+		unsigned xcr0()
+		{
+#if defined(_MSC_VER)
+			return (unsigned)_xgetbv(0);
+#else
+			unsigned eax, edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return eax;
+#endif
+		}
+
+		bool cpu_has_sse2()
+		{
+			unsigned r[4];
+			cpuid(1, r);
+
+			return (r[3] >> 26) & 1;
+		}
+
+		bool cpu_has_avx2()
+		{
+			unsigned r[4];
+			cpuid(0, r);
+
+			if (r[0] < 7)
+				return false;
+
+			cpuid(1, r);
+
+			bool fma = (r[2] >> 12) & 1;
+			bool osxsave = (r[2] >> 27) & 1;
+			bool avx = (r[2] >> 28) & 1;
+			bool f16c = (r[2] >> 29) & 1;
+
+			//the os must save the ymm registers on context switches
+			if (!fma || !osxsave || !avx || !f16c || (xcr0() & 6) != 6)
+				return false;
+
+			cpuid(7, r);
+			return (r[1] >> 5) & 1;
+		}
+#endif
+
+		//returns the kernels of 'b', or nullptr if they aren't built in or the cpu can't run them
+		//the cpu is only queried once
+		const kernel_table* table(backend b)
+		{
+			switch (b)
+			{
+			case backend::scalar:
+				return &scalar_kernels;
+#if defined(VECMATH_KERNELS_SSE2)
+			case backend::sse2:
+			{
+				static const bool supported = cpu_has_sse2();
+				return supported ? &sse2_kernels : nullptr;
+			}
+#endif
+#if defined(VECMATH_KERNELS_AVX2)
+			case backend::avx2:
+			{
+				static const bool supported = cpu_has_avx2();
+				return supported ? &avx2_kernels : nullptr;
+			}
+#endif
+			default:
+				return nullptr;
+			}
+		}
+
+		//returns the backend named by VECMATH_BACKEND if it is supported, otherwise the best supported one
+		const kernel_table* initial_table()
+		{
+			const char* name = std::getenv("VECMATH_BACKEND");
+
+			for (backend b : { backend::avx2, backend::sse2, backend::scalar })
+			{
+				if (name && !std::strcmp(name, backend_name(b)) && table(b))
+					return table(b);
+			}
+
+			for (backend b : { backend::avx2, backend::sse2 })
+			{
+				if (table(b))
+					return table(b);
+			}
+
+			return &scalar_kernels;
+		}
+
+		std::atomic<const kernel_table*>& active()
+		{
+			static std::atomic<const kernel_table*> kernels(initial_table());
+			return kernels;
+		}
+	}
+
+	const kernel_table& kernels()
+	{
+		return *active().load(std::memory_order_acquire);
+	}
+
+	backend active_backend()
+	{
+		const kernel_table* k = active().load(std::memory_order_acquire);
+
+		for (backend b : { backend::avx2, backend::sse2 })
+		{
+			if (k == table(b))
+				return b;
+		}
+
+		return backend::scalar;
+	}
+
+	bool backend_supported(backend b)
+	{
+		return table(b) != nullptr;
+	}
+
+	bool set_backend(backend b)
+	{
+		const kernel_table* k = table(b);
+
+		if (!k)
+			return false;
+
+		active().store(k, std::memory_order_release);
+		return true;
+	}
+
+	const char* backend_name(backend b)
+	{
+		switch (b)
+		{
+		case backend::scalar: return "scalar";
+		case backend::sse2: return "sse2";
+		case backend::avx2: return "avx2";
+		default: return "unknown";
+		}
+	}
+}
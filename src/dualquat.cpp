@@ -0,0 +1,5 @@
+#include <vecmath/dualquat.hpp>
+
+#ifndef VECMATH_HEADER_ONLY
+#include <vecmath/dualquat.inl>
+#endif
@@ -0,0 +1,21 @@
+#include <vecmath/fastmath.hpp>
+
+#ifndef VECMATH_HEADER_ONLY
+#include <vecmath/fastmath.inl>
+#endif
+
+#include "kernels.hpp"
+
+namespace vcm
+{
+	void sincos_fast(const float* x, float* s, float* c, std::size_t n)
+	{
+		kernels().sincos_fast(x, s, c, n);
+	}
+
+	void normalize_fast(const vec3_soa& v, vec3_soa& out)
+	{
+		out.resize(v.size());
+		kernels().normalize3_fast(v, out);
+	}
+}
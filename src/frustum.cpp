@@ -0,0 +1,30 @@
+#include <vecmath/frustum.hpp>
+
+#ifndef VECMATH_HEADER_ONLY
+#include <vecmath/frustum.inl>
+#endif
+
+#include "kernels.hpp"
+
+namespace vcm
+{
+	void cull_spheres(const frustum& f, const vec3_soa& centers, const float* radii, std::uint32_t* mask)
+	{
+		kernels().cull_spheres(f, centers, radii, mask);
+	}
+
+	std::size_t cull_spheres_compact(const frustum& f, const vec3_soa& centers, const float* radii, std::uint32_t* indices)
+	{
+		return kernels().cull_spheres_compact(f, centers, radii, indices);
+	}
+
+	void cull_aabbs(const frustum& f, const vec3_soa& min, const vec3_soa& max, std::uint32_t* mask)
+	{
+		kernels().cull_aabbs(f, min, max, mask);
+	}
+
+	std::size_t cull_aabbs_compact(const frustum& f, const vec3_soa& min, const vec3_soa& max, std::uint32_t* indices)
+	{
+		return kernels().cull_aabbs_compact(f, min, max, indices);
+	}
+}
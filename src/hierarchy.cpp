@@ -0,0 +1,189 @@
+#include <vecmath/hierarchy.hpp>
+
+#include "task_pool.hpp"
+
+#include <algorithm>
+
+namespace vcm
+{
+	namespace
+	{
+		//nodes per pool task when updating a level
+		const std::size_t update_grain = 256;
+
+		const std::size_t unknown_depth = (std::size_t)-1;
+	}
+
+	const std::size_t transform_hierarchy::no_parent;
+
+	transform_hierarchy::transform_hierarchy(unsigned threads) :
+		structure_changed(false),
+		any_dirty(false),
+		pool(new task_pool(threads))
+	{
+	}
+
+	transform_hierarchy::~transform_hierarchy()
+	{
+		delete pool;
+	}
+
+	std::size_t transform_hierarchy::add(const mat4& local, std::size_t parent)
+	{
+		locals.push_back(local);
+		worlds.push_back(local);
+		parents.push_back(parent);
+		dirty.push_back(1);
+		changed.push_back(0);
+
+		structure_changed = true;
+		any_dirty = true;
+
+		return locals.size() - 1;
+	}
+
+	void transform_hierarchy::assign(const mat4* locals, const std::size_t* parents, std::size_t n)
+	{
+		this->locals.assign(locals, locals + n);
+		this->worlds.assign(locals, locals + n);
+		this->parents.assign(parents, parents + n);
+		dirty.assign(n, 1);
+		changed.assign(n, 0);
+
+		structure_changed = true;
+		any_dirty = true;
+	}
+
+	bool transform_hierarchy::set_parent(std::size_t i, std::size_t parent)
+	{
+		//'i' can't go under itself or one of its descendants; the walk is bounded in case of an earlier cycle
+		std::size_t node = parent;
+
+		for (std::size_t steps = 0; node != no_parent && steps <= parents.size(); ++steps)
+		{
+			if (node == i)
+				return false;
+
+			node = parents[node];
+		}
+
+		parents[i] = parent;
+		dirty[i] = 1;
+
+		structure_changed = true;
+		any_dirty = true;
+
+		return true;
+	}
+
+	void transform_hierarchy::set_local(std::size_t i, const mat4& local)
+	{
+		locals[i] = local;
+		dirty[i] = 1;
+
+		any_dirty = true;
+	}
+
+	void transform_hierarchy::build_levels()
+	{
+		std::size_t n = locals.size();
+
+		//depth of every node, walking up to the nearest node with a known depth
+		//a walk longer than the hierarchy is in a cycle (which assign() doesn't check for), and stops there as if
+		//at a root, so the update ends, with undefined world transforms for the nodes of the cycle
+		depths.assign(n, unknown_depth);
+		std::vector<std::size_t> path;
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			std::size_t node = i;
+
+			while (depths[node] == unknown_depth)
+			{
+				path.push_back(node);
+
+				if (parents[node] == no_parent || path.size() > n)
+					break;
+
+				node = parents[node];
+			}
+
+			std::size_t depth = depths[node] == unknown_depth ? 0 : depths[node] + 1;
+
+			while (!path.empty())
+			{
+				if (depths[path.back()] == unknown_depth)
+					depths[path.back()] = depth++;
+
+				path.pop_back();
+			}
+		}
+
+		//counting sort by depth, so every level is a contiguous range of 'order'
+		std::size_t count = n == 0 ? 0 : *std::max_element(depths.begin(), depths.end()) + 1;
+		levels.assign(count + 1, 0);
+
+		for (std::size_t i = 0; i < n; ++i)
+			++levels[depths[i] + 1];
+
+		for (std::size_t l = 1; l <= count; ++l)
+			levels[l] += levels[l - 1];
+
+		order.resize(n);
+		std::vector<std::size_t> next(levels.begin(), levels.end() - 1);
+
+		for (std::size_t i = 0; i < n; ++i)
+			order[next[depths[i]]++] = i;
+
+		structure_changed = false;
+	}
+
+	void transform_hierarchy::update()
+	{
+		if (!any_dirty)
+			return;
+
+		if (structure_changed)
+			build_levels();
+
+		//levels above the shallowest dirty node are unchanged
+		std::size_t first = levels.size();
+
+		for (std::size_t i = 0; i < dirty.size(); ++i)
+		{
+			if (dirty[i] && depths[i] < first)
+				first = depths[i];
+		}
+
+		std::fill(changed.begin(), changed.end(), 0);
+
+		for (std::size_t l = first; l + 1 < levels.size(); ++l)
+		{
+			std::size_t begin = levels[l];
+			std::size_t end = levels[l + 1];
+			std::size_t tasks = (end - begin + update_grain - 1) / update_grain;
+
+			pool->run(tasks, [&](std::size_t t)
+			{
+				std::size_t from = begin + t * update_grain;
+				std::size_t to = std::min(from + update_grain, end);
+
+				for (std::size_t k = from; k < to; ++k)
+				{
+					std::size_t i = order[k];
+					std::size_t p = parents[i];
+
+					//nodes in untouched subtrees keep their world transform
+					if (!dirty[i] && (p == no_parent || !changed[p]))
+						continue;
+
+					worlds[i] = p == no_parent ? locals[i] : worlds[p] * locals[i];
+					changed[i] = 1;
+				}
+			});
+		}
+
+		std::fill(dirty.begin(), dirty.end(), 0);
+		any_dirty = false;
+	}
+}
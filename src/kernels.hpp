@@ -0,0 +1,110 @@
+#ifndef VECMATH_KERNELS_H
+#define VECMATH_KERNELS_H
+
+#include <vecmath/aabb.hpp>
+#include <vecmath/affine.hpp>
+#include <vecmath/backend.hpp>
+#include <vecmath/bvh.hpp>
+#include <vecmath/fastmath.hpp>
+#include <vecmath/frustum.hpp>
+#include <vecmath/packed.hpp>
+#include <vecmath/skinning.hpp>
+#include <vecmath/soa.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+//private to the library: the array kernels, compiled once per instruction set (kernels.inl, built by
+//kernels_scalar.cpp, kernels_sse2.cpp and kernels_avx2.cpp) and called through the table of the
+//backend selected at run time (dispatch.cpp)
+
+//the instruction sets the kernels are built for besides the scalar code: with VECMATH_SSE on x86,
+//where every backend is compiled into the library and only used on cpus that support it
+#if defined(VECMATH_SSE) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+	#define VECMATH_KERNELS_SSE2
+	#define VECMATH_KERNELS_AVX2
+#endif
+
+namespace vcm
+{
+	struct kernel_table
+	{
+		//batch.hpp; the compose kernels write elements 'begin' to 'end' - 1, so they can be split across threads
+		void (*transform_points)(const mat4& m, const vec3* in, vec3* out, std::size_t n);
+		void (*transform_vectors)(const mat4& m, const vec3* in, vec3* out, std::size_t n);
+		void (*transform_aabbs)(const mat4& m, const aabb* in, aabb* out, std::size_t n);
+		void (*multiply)(const mat4* a, const mat4* b, mat4* out, std::size_t n);
+		void (*normal_matrices)(const float* in, unsigned in_pitch, float* out, unsigned out_pitch, std::size_t n, normal_scale scale);
+		void (*compose)(const vec3* tran, const quat* rot, const vec3* scale, mat4* out, std::size_t begin, std::size_t end);
+		void (*compose_soa)(const vec3_soa& tran, const quat_soa& rot, const vec3_soa& scale, mat4* out, std::size_t begin, std::size_t end);
+		void (*slerp)(const quat* a, const quat* b, float t, quat* out, std::size_t n);
+		void (*slerp_array)(const quat* a, const quat* b, const float* t, quat* out, std::size_t n);
+		void (*nlerp)(const quat* a, const quat* b, float t, quat* out, std::size_t n);
+		void (*nlerp_array)(const quat* a, const quat* b, const float* t, quat* out, std::size_t n);
+		void (*rotate)(const quat* q, const vec3* in, vec3* out, std::size_t n, bool inverse);
+		void (*rotate_soa)(const quat_soa& q, const vec3_soa& in, vec3_soa& out, bool inverse);
+
+		//frustum.hpp
+		void (*cull_spheres)(const frustum& f, const vec3_soa& centers, const float* radii, std::uint32_t* mask);
+		std::size_t (*cull_spheres_compact)(const frustum& f, const vec3_soa& centers, const float* radii, std::uint32_t* indices);
+		void (*cull_aabbs)(const frustum& f, const vec3_soa& min, const vec3_soa& max, std::uint32_t* mask);
+		std::size_t (*cull_aabbs_compact)(const frustum& f, const vec3_soa& min, const vec3_soa& max, std::uint32_t* indices);
+
+		//packed.hpp; the half conversions work on 'n' single floats
+		void (*to_halves)(const float* in, std::uint16_t* out, std::size_t n);
+		void (*from_halves)(const std::uint16_t* in, float* out, std::size_t n);
+		void (*pack_quats)(const quat* in, packed_quat* out, std::size_t n);
+		void (*unpack_quats)(const packed_quat* in, quat* out, std::size_t n);
+		void (*pack_normals3)(const vec3* in, packed_normal* out, std::size_t n);
+		void (*pack_normals4)(const vec4* in, packed_normal* out, std::size_t n);
+		void (*unpack_normals3)(const packed_normal* in, vec3* out, std::size_t n);
+		void (*unpack_normals4)(const packed_normal* in, vec4* out, std::size_t n);
+
+		//soa.hpp; the output streams are already resized
+		void (*split3)(const vec3* in, float* x, float* y, float* z, std::size_t n);
+		void (*join3)(const float* x, const float* y, const float* z, vec3* out, std::size_t n);
+		void (*split4)(const quat* in, float* x, float* y, float* z, float* w, std::size_t n);
+		void (*join4)(const float* x, const float* y, const float* z, const float* w, quat* out, std::size_t n);
+		void (*length3)(const vec3_soa& v, float* out);
+		void (*dot3)(const vec3_soa& a, const vec3_soa& b, float* out);
+		void (*normalize3)(const vec3_soa& v, vec3_soa& out);
+		void (*cross3)(const vec3_soa& a, const vec3_soa& b, vec3_soa& out);
+		void (*lerp3)(const vec3_soa& a, const vec3_soa& b, float t, vec3_soa& out);
+		void (*length4)(const quat_soa& q, float* out);
+		void (*dot4)(const quat_soa& a, const quat_soa& b, float* out);
+		void (*normalize4)(const quat_soa& q, quat_soa& out);
+		void (*lerp4)(const quat_soa& a, const quat_soa& b, float t, quat_soa& out);
+
+		//skinning.hpp; the kernels skin vertices 'begin' to 'end' - 1, so they can be split across threads
+		//the linear palette has 'pitch' floats per column (4 for mat4, 3 for affine3); 'normals' and
+		//'out_normals' are null when only the positions are skinned, and the output streams are already resized
+		void (*skin_linear)(const float* palette, unsigned pitch, const skin_influences& influences, const vec3_soa& positions, const vec3_soa* normals, vec3_soa& out_positions, vec3_soa* out_normals, std::size_t begin, std::size_t end);
+		void (*skin_dual_quat)(const dualquat* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa* normals, vec3_soa& out_positions, vec3_soa* out_normals, std::size_t begin, std::size_t end);
+
+		//bvh.hpp; the mask of occluded_rays is already cleared
+		void (*intersect_rays)(const bvh& tree, const ray* rays, ray_hit* hits, std::size_t n);
+		void (*occluded_rays)(const bvh& tree, const ray* rays, std::uint32_t* mask, std::size_t n);
+
+		//fastmath.hpp; the output streams are already resized
+		void (*sincos_fast)(const float* x, float* s, float* c, std::size_t n);
+		void (*normalize3_fast)(const vec3_soa& v, vec3_soa& out);
+
+		//pointstream.hpp
+		aabb (*transform_points_bounds)(const mat4& m, const vec3* in, vec3* out, std::size_t n);
+	};
+
+	extern const kernel_table scalar_kernels;
+
+#if defined(VECMATH_KERNELS_SSE2)
+	extern const kernel_table sse2_kernels;
+#endif
+
+#if defined(VECMATH_KERNELS_AVX2)
+	extern const kernel_table avx2_kernels;
+#endif
+
+	//returns the kernels of active_backend()
+	const kernel_table& kernels();
+}
+
+#endif
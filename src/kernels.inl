@@ -0,0 +1,1858 @@
+//the array kernels, written once against simd::vfloat
+//included by kernels_scalar.cpp, kernels_sse2.cpp, and kernels_avx2.cpp, which define the instruction set
+//(VECMATH_KERNEL_SCALAR, VECMATH_KERNEL_SSE2, or VECMATH_KERNEL_AVX2) and the name of their table
+
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//everything above is compiled for the baseline instruction set; only the kernels below are built for
+//the instruction set of the including file, since they only run on cpus that support it
+#if defined(__clang__)
+	#if defined(VECMATH_KERNEL_AVX2)
+		#pragma clang attribute push(__attribute__((target("avx2,fma,f16c"))), apply_to = function)
+	#elif defined(VECMATH_KERNEL_SSE2)
+		#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+	#endif
+#elif defined(__GNUC__)
+	#pragma GCC push_options
+
+	#if defined(VECMATH_KERNEL_AVX2)
+		#pragma GCC target("avx2,fma,f16c")
+	#elif defined(VECMATH_KERNEL_SSE2)
+		#pragma GCC target("sse2")
+	#endif
+#endif
+
+#include "vfloat.hpp"
+#include "vmath.hpp"
+
+namespace vcm
+{
+	namespace
+	{
+		using namespace simd;
+
+		//BATCH.HPP
+
+		//transforms 'n' vec3s by the upper 3x4 part of 'm'; the translation is only added for points
+		template <bool Point>
+		void transform3(const mat4& m, const vec3* in, vec3* out, std::size_t n)
+		{
+			vfloat m00 = splat(m[0][0]), m01 = splat(m[0][1]), m02 = splat(m[0][2]);
+			vfloat m10 = splat(m[1][0]), m11 = splat(m[1][1]), m12 = splat(m[1][2]);
+			vfloat m20 = splat(m[2][0]), m21 = splat(m[2][1]), m22 = splat(m[2][2]);
+			vfloat m30 = splat(m[3][0]), m31 = splat(m[3][1]), m32 = splat(m[3][2]);
+
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				vfloat x, y, z;
+				load3(in[i].m, x, y, z);
+
+				vfloat rx = madd(m20, z, madd(m10, y, m00 * x));
+				vfloat ry = madd(m21, z, madd(m11, y, m01 * x));
+				vfloat rz = madd(m22, z, madd(m12, y, m02 * x));
+
+				if (Point)
+				{
+					rx += m30;
+					ry += m31;
+					rz += m32;
+				}
+
+				store3(out[i].m, rx, ry, rz);
+			}
+
+			//remaining elements
+			for (; i < n; ++i)
+			{
+				vec3 v = in[i];
+				vec3 r = vec3(m.m[0]) * v.x + vec3(m.m[1]) * v.y + vec3(m.m[2]) * v.z;
+
+				if (Point)
+					r += vec3(m.m[3]);
+
+				out[i] = r;
+			}
+		}
+
+		void transform_points(const mat4& m, const vec3* in, vec3* out, std::size_t n)
+		{
+			transform3<true>(m, in, out, n);
+		}
+
+		void transform_vectors(const mat4& m, const vec3* in, vec3* out, std::size_t n)
+		{
+			transform3<false>(m, in, out, n);
+		}
+
+		//transforms 'n' boxes by the upper 3x4 part of 'm' with arvo's method, like transform(m, box)
+		void transform_aabbs(const mat4& m, const aabb* in, aabb* out, std::size_t n)
+		{
+			vfloat m00 = splat(m[0][0]), m01 = splat(m[0][1]), m02 = splat(m[0][2]);
+			vfloat m10 = splat(m[1][0]), m11 = splat(m[1][1]), m12 = splat(m[1][2]);
+			vfloat m20 = splat(m[2][0]), m21 = splat(m[2][1]), m22 = splat(m[2][2]);
+			vfloat m30 = splat(m[3][0]), m31 = splat(m[3][1]), m32 = splat(m[3][2]);
+
+			vfloat a00 = abs(m00), a01 = abs(m01), a02 = abs(m02);
+			vfloat a10 = abs(m10), a11 = abs(m11), a12 = abs(m12);
+			vfloat a20 = abs(m20), a21 = abs(m21), a22 = abs(m22);
+
+			vfloat half = splat(0.5f);
+
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				//the boxes are read as 2 * width vec3s alternating between min and max
+				const float* p = in[i].min.m;
+
+				vfloat ax, ay, az, bx, by, bz;
+				load3(p, ax, ay, az);
+				load3(p + 3 * width, bx, by, bz);
+
+				vfloat minx, miny, minz, maxx, maxy, maxz;
+				deinterleave(ax, bx, minx, maxx);
+				deinterleave(ay, by, miny, maxy);
+				deinterleave(az, bz, minz, maxz);
+
+				vfloat cx = (minx + maxx) * half, cy = (miny + maxy) * half, cz = (minz + maxz) * half;
+				vfloat ex = (maxx - minx) * half, ey = (maxy - miny) * half, ez = (maxz - minz) * half;
+
+				vfloat tcx = madd(m20, cz, madd(m10, cy, m00 * cx)) + m30;
+				vfloat tcy = madd(m21, cz, madd(m11, cy, m01 * cx)) + m31;
+				vfloat tcz = madd(m22, cz, madd(m12, cy, m02 * cx)) + m32;
+
+				vfloat tex = madd(a20, ez, madd(a10, ey, a00 * ex));
+				vfloat tey = madd(a21, ez, madd(a11, ey, a01 * ex));
+				vfloat tez = madd(a22, ez, madd(a12, ey, a02 * ex));
+
+				//empty boxes are copied as they are
+				vmask keep = (minx > maxx) | (miny > maxy) | (minz > maxz);
+
+				minx = select(keep, minx, tcx - tex);
+				miny = select(keep, miny, tcy - tey);
+				minz = select(keep, minz, tcz - tez);
+				maxx = select(keep, maxx, tcx + tex);
+				maxy = select(keep, maxy, tcy + tey);
+				maxz = select(keep, maxz, tcz + tez);
+
+				interleave(minx, maxx, ax, bx);
+				interleave(miny, maxy, ay, by);
+				interleave(minz, maxz, az, bz);
+
+				float* q = out[i].min.m;
+				store3(q, ax, ay, az);
+				store3(q + 3 * width, bx, by, bz);
+			}
+
+			//remaining elements
+			for (; i < n; ++i)
+				out[i] = transform(m, in[i]);
+		}
+
+		//writes a[i] * b[i] to 'out'; each result column is a linear combination of the columns of 'a'
+		void multiply(const mat4* a, const mat4* b, mat4* out, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+#if defined(VECMATH_KERNEL_AVX2)
+				//two result columns per iteration
+				const __m256 c0 = _mm256_broadcast_ps((const __m128*)a[i].m[0].m);
+				const __m256 c1 = _mm256_broadcast_ps((const __m128*)a[i].m[1].m);
+				const __m256 c2 = _mm256_broadcast_ps((const __m128*)a[i].m[2].m);
+				const __m256 c3 = _mm256_broadcast_ps((const __m128*)a[i].m[3].m);
+
+				__m256 b01 = _mm256_loadu_ps(b[i].m[0].m);
+				__m256 b23 = _mm256_loadu_ps(b[i].m[2].m);
+
+				__m256 r01 = _mm256_mul_ps(c0, _mm256_permute_ps(b01, 0x00));
+				r01 = _mm256_fmadd_ps(c1, _mm256_permute_ps(b01, 0x55), r01);
+				r01 = _mm256_fmadd_ps(c2, _mm256_permute_ps(b01, 0xAA), r01);
+				r01 = _mm256_fmadd_ps(c3, _mm256_permute_ps(b01, 0xFF), r01);
+
+				__m256 r23 = _mm256_mul_ps(c0, _mm256_permute_ps(b23, 0x00));
+				r23 = _mm256_fmadd_ps(c1, _mm256_permute_ps(b23, 0x55), r23);
+				r23 = _mm256_fmadd_ps(c2, _mm256_permute_ps(b23, 0xAA), r23);
+				r23 = _mm256_fmadd_ps(c3, _mm256_permute_ps(b23, 0xFF), r23);
+
+				_mm256_storeu_ps(out[i].m[0].m, r01);
+				_mm256_storeu_ps(out[i].m[2].m, r23);
+#elif defined(VECMATH_KERNEL_SSE2)
+				const __m128 c0 = _mm_loadu_ps(a[i].m[0].m);
+				const __m128 c1 = _mm_loadu_ps(a[i].m[1].m);
+				const __m128 c2 = _mm_loadu_ps(a[i].m[2].m);
+				const __m128 c3 = _mm_loadu_ps(a[i].m[3].m);
+
+				__m128 r[4];
+
+				for (unsigned j = 0; j < 4; ++j)
+				{
+					__m128 bj = _mm_loadu_ps(b[i].m[j].m);
+
+					r[j] = _mm_mul_ps(c0, _mm_shuffle_ps(bj, bj, 0x00));
+					r[j] = _mm_add_ps(r[j], _mm_mul_ps(c1, _mm_shuffle_ps(bj, bj, 0x55)));
+					r[j] = _mm_add_ps(r[j], _mm_mul_ps(c2, _mm_shuffle_ps(bj, bj, 0xAA)));
+					r[j] = _mm_add_ps(r[j], _mm_mul_ps(c3, _mm_shuffle_ps(bj, bj, 0xFF)));
+				}
+
+				for (unsigned j = 0; j < 4; ++j)
+					_mm_storeu_ps(out[i].m[j].m, r[j]);
+#else
+				out[i] = detail::product(a[i], b[i]);
+#endif
+			}
+		}
+
+		//normal_matrices() with the pitches known at compile time
+		//the nine elements are moved between the matrices and the lanes with strided 4 float transposes:
+		//one per column for 4 float columns, otherwise at offsets 0, 4, and 5 of the packed elements,
+		//which stay inside the nine floats of each matrix (the last two overlap, with the same values)
+		template <unsigned InPitch, unsigned OutPitch>
+		void normal_matrices_pitched(const float* in, float* out, std::size_t n, normal_scale scale)
+		{
+			std::size_t in_size = 4 * InPitch, out_size = 3 * OutPitch;
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				const float* p = in + i * in_size;
+				vfloat x0, y0, z0, x1, y1, z1, x2, y2, z2, w;
+
+				if (InPitch == 4)
+				{
+					load4(p, in_size, x0, y0, z0, w);
+					load4(p + 4, in_size, x1, y1, z1, w);
+					load4(p + 8, in_size, x2, y2, z2, w);
+				}
+				else
+				{
+					load4(p, in_size, x0, y0, z0, x1);
+					load4(p + 4, in_size, y1, z1, x2, y2);
+					load4(p + 5, in_size, w, w, w, z2);
+				}
+
+				//cross(c1, c2), cross(c2, c0), and cross(c0, c1), like normal_matrix()
+				vfloat r[9] =
+				{
+					y1 * z2 - z1 * y2, z1 * x2 - x1 * z2, x1 * y2 - y1 * x2,
+					y2 * z0 - z2 * y0, z2 * x0 - x2 * z0, x2 * y0 - y2 * x0,
+					y0 * z1 - z0 * y1, z0 * x1 - x0 * z1, x0 * y1 - y0 * x1
+				};
+
+				vfloat det = madd(z0, r[2], madd(y0, r[1], x0 * r[0]));
+				vfloat s = scale == normal_scale::exact ? splat(1) / det : select(det < splat(0), splat(-1), splat(1));
+				s = select(det == splat(0), splat(1), s);
+
+				for (unsigned k = 0; k < 9; ++k)
+					r[k] *= s;
+
+				float* o = out + i * out_size;
+
+				if (OutPitch == 4)
+				{
+					store4(o, out_size, r[0], r[1], r[2], splat(0));
+					store4(o + 4, out_size, r[3], r[4], r[5], splat(0));
+					store4(o + 8, out_size, r[6], r[7], r[8], splat(0));
+				}
+				else
+				{
+					store4(o, out_size, r[0], r[1], r[2], r[3]);
+					store4(o + 4, out_size, r[4], r[5], r[6], r[7]);
+					store4(o + 5, out_size, r[5], r[6], r[7], r[8]);
+				}
+			}
+
+			//remaining elements
+			for (; i < n; ++i)
+			{
+				const float* m = in + i * in_size;
+				const float* c1 = m + InPitch;
+				const float* c2 = m + 2 * InPitch;
+
+				mat3 nm = normal_matrix(mat3(vec3(m[0], m[1], m[2]), vec3(c1[0], c1[1], c1[2]), vec3(c2[0], c2[1], c2[2])), scale);
+
+				float* o = out + i * out_size;
+
+				for (unsigned c = 0; c < 3; ++c)
+				{
+					o[c * OutPitch] = nm.m[c].x;
+					o[c * OutPitch + 1] = nm.m[c].y;
+					o[c * OutPitch + 2] = nm.m[c].z;
+
+					if (OutPitch == 4)
+						o[c * OutPitch + 3] = 0;
+				}
+			}
+		}
+
+		//writes the normal matrices of 'n' matrices, whose first three columns are 'in_pitch' floats apart
+		//(4 for mat4, 3 for affine3), as three columns 'out_pitch' floats apart (3 for mat3, 4 for std140)
+		void normal_matrices(const float* in, unsigned in_pitch, float* out, unsigned out_pitch, std::size_t n, normal_scale scale)
+		{
+			if (in_pitch == 4)
+				out_pitch == 4 ? normal_matrices_pitched<4, 4>(in, out, n, scale) : normal_matrices_pitched<4, 3>(in, out, n, scale);
+			else
+				out_pitch == 4 ? normal_matrices_pitched<3, 4>(in, out, n, scale) : normal_matrices_pitched<3, 3>(in, out, n, scale);
+		}
+
+		//writes compose(t, q, s) for one group of simd lanes to 'out'
+		void compose_lanes(vfloat tx, vfloat ty, vfloat tz, vfloat qx, vfloat qy, vfloat qz, vfloat qw, vfloat sx, vfloat sy, vfloat sz, mat4* out)
+		{
+			//normalize the rotations like mat3(const quat&), leaving zero quaternions as they are
+			vfloat len = sqrt(madd(qw, qw, madd(qz, qz, madd(qy, qy, qx * qx))));
+			vfloat inv = select(len == splat(0), splat(1), splat(1) / len);
+
+			qx *= inv;
+			qy *= inv;
+			qz *= inv;
+			qw *= inv;
+
+			vfloat one = splat(1), two = splat(2), zero = splat(0);
+
+			vfloat x2 = qx * two, y2 = qy * two, z2 = qz * two;
+			vfloat xx = qx * x2, yy = qy * y2, zz = qz * z2;
+			vfloat xy = qx * y2, xz = qx * z2, yz = qy * z2;
+			vfloat xw = qw * x2, yw = qw * y2, zw = qw * z2;
+
+			//each column is written as 'width' consecutive vec4s, then copied into the matrices
+			vec4 cols[4][width];
+
+			store4(cols[0][0].m, (one - yy - zz) * sx, (xy + zw) * sx, (xz - yw) * sx, zero);
+			store4(cols[1][0].m, (xy - zw) * sy, (one - xx - zz) * sy, (yz + xw) * sy, zero);
+			store4(cols[2][0].m, (xz + yw) * sz, (yz - xw) * sz, (one - xx - yy) * sz, zero);
+			store4(cols[3][0].m, tx, ty, tz, one);
+
+			for (unsigned j = 0; j < width; ++j)
+			{
+				out[j].m[0] = cols[0][j];
+				out[j].m[1] = cols[1][j];
+				out[j].m[2] = cols[2][j];
+				out[j].m[3] = cols[3][j];
+			}
+		}
+
+		void compose(const vec3* tran, const quat* rot, const vec3* scale, mat4* out, std::size_t begin, std::size_t end)
+		{
+			std::size_t i = begin;
+
+			for (; i + width <= end; i += width)
+			{
+				vfloat tx, ty, tz, qx, qy, qz, qw, sx, sy, sz;
+
+				load3(tran[i].m, tx, ty, tz);
+				load4(rot[i].m, qx, qy, qz, qw);
+				load3(scale[i].m, sx, sy, sz);
+
+				compose_lanes(tx, ty, tz, qx, qy, qz, qw, sx, sy, sz, out + i);
+			}
+
+			for (; i < end; ++i)
+				out[i] = vcm::compose(tran[i], rot[i], scale[i]);
+		}
+
+		void compose_soa(const vec3_soa& tran, const quat_soa& rot, const vec3_soa& scale, mat4* out, std::size_t begin, std::size_t end)
+		{
+			std::size_t i = begin;
+
+			for (; i + width <= end; i += width)
+			{
+				compose_lanes(
+					load(tran.x + i), load(tran.y + i), load(tran.z + i),
+					load(rot.x + i), load(rot.y + i), load(rot.z + i), load(rot.w + i),
+					load(scale.x + i), load(scale.y + i), load(scale.z + i),
+					out + i);
+			}
+
+			for (; i < end; ++i)
+				out[i] = vcm::compose(tran[i], rot[i], scale[i]);
+		}
+
+		//returns 'x', 'y', 'z', and 'w' scaled to unit length, leaving zero quaternions as they are
+		void normalize_lanes(vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			vfloat len = sqrt(madd(w, w, madd(z, z, madd(y, y, x * x))));
+			vfloat inv = select(len == splat(0), splat(1), splat(1) / len);
+
+			x *= inv;
+			y *= inv;
+			z *= inv;
+			w *= inv;
+		}
+
+		//slerp for one group of simd lanes; 'a' is overwritten with the result
+		struct slerp_lanes
+		{
+			void operator()(vfloat* a, vfloat* b, vfloat t) const
+			{
+				vfloat d = madd(a[3], b[3], madd(a[2], b[2], madd(a[1], b[1], a[0] * b[0])));
+
+				//take the shorter arc
+				vmask neg = d < splat(0);
+
+				for (unsigned k = 0; k < 4; ++k)
+					b[k] = select(neg, -b[k], b[k]);
+
+				d = min(abs(d), splat(1));
+				t = min(max(t, splat(0)), splat(1));
+
+				vfloat angle = acos01(d);
+
+				//nearly parallel quaternions are lerped, like slerp()
+				vmask near = d > splat(0.995f);
+				vfloat inv = splat(1) / select(near, splat(1), sin_half_pi(angle));
+
+				vfloat wa = select(near, splat(1) - t, sin_half_pi((splat(1) - t) * angle) * inv);
+				vfloat wb = select(near, t, sin_half_pi(t * angle) * inv);
+
+				for (unsigned k = 0; k < 4; ++k)
+					a[k] = madd(b[k], wb, a[k] * wa);
+
+				normalize_lanes(a[0], a[1], a[2], a[3]);
+			}
+		};
+
+		//nlerp for one group of simd lanes; 'a' is overwritten with the result
+		struct nlerp_lanes
+		{
+			void operator()(vfloat* a, vfloat* b, vfloat t) const
+			{
+				vfloat d = madd(a[3], b[3], madd(a[2], b[2], madd(a[1], b[1], a[0] * b[0])));
+
+				//take the shorter arc
+				vfloat wb = select(d < splat(0), -t, t);
+				vfloat wa = splat(1) - t;
+
+				for (unsigned k = 0; k < 4; ++k)
+					a[k] = madd(b[k], wb, a[k] * wa);
+
+				normalize_lanes(a[0], a[1], a[2], a[3]);
+			}
+		};
+
+		//one interpolation factor for every element
+		struct uniform_factor
+		{
+			float t;
+
+			vfloat lanes(std::size_t) const { return splat(t); }
+			float at(std::size_t) const { return t; }
+		};
+
+		//an interpolation factor per element
+		struct array_factor
+		{
+			const float* t;
+
+			vfloat lanes(std::size_t i) const { return load(t + i); }
+			float at(std::size_t i) const { return t[i]; }
+		};
+
+		//runs 'kernel' over 'n' pairs of quaternions, with the factors of element 'i' given by 'factors'
+		//the last partial group is copied through padded buffers so it gets the same kernel
+		template <typename K, typename T>
+		void blend_quats(const quat* a, const quat* b, T factors, quat* out, std::size_t n, K kernel)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				vfloat va[4], vb[4];
+				load4(a[i].m, va[0], va[1], va[2], va[3]);
+				load4(b[i].m, vb[0], vb[1], vb[2], vb[3]);
+
+				kernel(va, vb, factors.lanes(i));
+
+				store4(out[i].m, va[0], va[1], va[2], va[3]);
+			}
+
+			if (i == n)
+				return;
+
+			quat pa[width], pb[width], pr[width];
+			float pt[width] = {};
+
+			for (std::size_t j = 0; i + j < n; ++j)
+			{
+				pa[j] = a[i + j];
+				pb[j] = b[i + j];
+				pt[j] = factors.at(i + j);
+			}
+
+			vfloat va[4], vb[4];
+			load4(pa[0].m, va[0], va[1], va[2], va[3]);
+			load4(pb[0].m, vb[0], vb[1], vb[2], vb[3]);
+
+			kernel(va, vb, load(pt));
+
+			store4(pr[0].m, va[0], va[1], va[2], va[3]);
+
+			for (std::size_t j = 0; i + j < n; ++j)
+				out[i + j] = pr[j];
+		}
+
+		void slerp(const quat* a, const quat* b, float t, quat* out, std::size_t n)
+		{
+			blend_quats(a, b, uniform_factor{ t }, out, n, slerp_lanes());
+		}
+
+		void slerp_array(const quat* a, const quat* b, const float* t, quat* out, std::size_t n)
+		{
+			blend_quats(a, b, array_factor{ t }, out, n, slerp_lanes());
+		}
+
+		void nlerp(const quat* a, const quat* b, float t, quat* out, std::size_t n)
+		{
+			blend_quats(a, b, uniform_factor{ t }, out, n, nlerp_lanes());
+		}
+
+		void nlerp_array(const quat* a, const quat* b, const float* t, quat* out, std::size_t n)
+		{
+			blend_quats(a, b, array_factor{ t }, out, n, nlerp_lanes());
+		}
+
+		//rotates 'x', 'y', and 'z' by the unit quaternions 'rx', 'ry', 'rz', and 'rw', like rotate(const quat&, const vec3&)
+		void rotate_lanes(vfloat rx, vfloat ry, vfloat rz, vfloat rw, vfloat& x, vfloat& y, vfloat& z)
+		{
+			vfloat two = splat(2);
+			vfloat tx = (ry * z - rz * y) * two;
+			vfloat ty = (rz * x - rx * z) * two;
+			vfloat tz = (rx * y - ry * x) * two;
+
+			x = madd(tx, rw, x) + (ry * tz - rz * ty);
+			y = madd(ty, rw, y) + (rz * tx - rx * tz);
+			z = madd(tz, rw, z) + (rx * ty - ry * tx);
+		}
+
+		//rotates the 'n' vectors 'in' by the quaternions 'q' (or their inverses) into 'out'
+		//the last partial group is copied through padded buffers, like blend_quats()
+		void rotate(const quat* q, const vec3* in, vec3* out, std::size_t n, bool inverse)
+		{
+			vfloat sign = splat(inverse ? -1.0f : 1.0f);
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				vfloat rx, ry, rz, rw, x, y, z;
+				load4(q[i].m, rx, ry, rz, rw);
+				load3(in[i].m, x, y, z);
+
+				rotate_lanes(rx * sign, ry * sign, rz * sign, rw, x, y, z);
+
+				store3(out[i].m, x, y, z);
+			}
+
+			if (i == n)
+				return;
+
+			quat pq[width];
+			vec3 pv[width];
+
+			for (std::size_t j = 0; i + j < n; ++j)
+			{
+				pq[j] = q[i + j];
+				pv[j] = in[i + j];
+			}
+
+			vfloat rx, ry, rz, rw, x, y, z;
+			load4(pq[0].m, rx, ry, rz, rw);
+			load3(pv[0].m, x, y, z);
+
+			rotate_lanes(rx * sign, ry * sign, rz * sign, rw, x, y, z);
+
+			store3(pv[0].m, x, y, z);
+
+			for (std::size_t j = 0; i + j < n; ++j)
+				out[i + j] = pv[j];
+		}
+
+		//rotates the stream 'in' by the stream 'q' (or its inverses) into 'out'; the padding rotates to zero
+		void rotate_soa(const quat_soa& q, const vec3_soa& in, vec3_soa& out, bool inverse)
+		{
+			vfloat sign = splat(inverse ? -1.0f : 1.0f);
+
+			for (std::size_t i = 0; i < in.size(); i += width)
+			{
+				vfloat x = load(in.x + i), y = load(in.y + i), z = load(in.z + i);
+				rotate_lanes(load(q.x + i) * sign, load(q.y + i) * sign, load(q.z + i) * sign, load(q.w + i), x, y, z);
+
+				store(out.x + i, x);
+				store(out.y + i, y);
+				store(out.z + i, z);
+			}
+		}
+
+		//FRUSTUM.HPP
+
+		//the planes of a frustum, each component splatted across the lanes
+		struct plane_lanes
+		{
+			explicit plane_lanes(const frustum& f)
+			{
+				for (unsigned p = 0; p < 6; ++p)
+				{
+					x[p] = splat(f.planes[p].x);
+					y[p] = splat(f.planes[p].y);
+					z[p] = splat(f.planes[p].z);
+					w[p] = splat(f.planes[p].w);
+
+					ax[p] = abs(x[p]);
+					ay[p] = abs(y[p]);
+					az[p] = abs(z[p]);
+				}
+			}
+
+			//returns the smallest signed distance of the points to the six planes
+			vfloat distance(vfloat px, vfloat py, vfloat pz) const
+			{
+				vfloat d = madd(z[0], pz, madd(y[0], py, madd(x[0], px, w[0])));
+
+				for (unsigned p = 1; p < 6; ++p)
+					d = min(d, madd(z[p], pz, madd(y[p], py, madd(x[p], px, w[p]))));
+
+				return d;
+			}
+
+			//returns the smallest signed distance of the boxes to the six planes, measured from
+			//the corner of each box furthest along the plane normal
+			vfloat distance(vfloat cx, vfloat cy, vfloat cz, vfloat ex, vfloat ey, vfloat ez) const
+			{
+				vfloat d = madd(z[0], cz, madd(y[0], cy, madd(x[0], cx, w[0]))) + madd(az[0], ez, madd(ay[0], ey, ax[0] * ex));
+
+				for (unsigned p = 1; p < 6; ++p)
+					d = min(d, madd(z[p], cz, madd(y[p], cy, madd(x[p], cx, w[p]))) + madd(az[p], ez, madd(ay[p], ey, ax[p] * ex)));
+
+				return d;
+			}
+
+			vfloat x[6], y[6], z[6], w[6];
+			vfloat ax[6], ay[6], az[6];
+		};
+
+		//tests the spheres starting at 'i', returning one bit per visible sphere
+		//the centers are padded, but 'radii' isn't, so the last partial group goes through a copy
+		struct spheres_visible
+		{
+			unsigned operator()(std::size_t i) const
+			{
+				vfloat r;
+
+				if (i + width <= centers.size())
+					r = load(radii + i);
+				else
+				{
+					float tail[width] = {};
+					std::copy(radii + i, radii + centers.size(), tail);
+					r = load(tail);
+				}
+
+				vfloat d = planes.distance(load(centers.x + i), load(centers.y + i), load(centers.z + i));
+				return bits(d >= -r);
+			}
+
+			const plane_lanes& planes;
+			const vec3_soa& centers;
+			const float* radii;
+		};
+
+		//tests the boxes starting at 'i', returning one bit per visible box
+		struct aabbs_visible
+		{
+			unsigned operator()(std::size_t i) const
+			{
+				vfloat half = splat(0.5f);
+
+				vfloat minx = load(min.x + i), miny = load(min.y + i), minz = load(min.z + i);
+				vfloat maxx = load(max.x + i), maxy = load(max.y + i), maxz = load(max.z + i);
+
+				vfloat d = planes.distance(
+					(minx + maxx) * half, (miny + maxy) * half, (minz + maxz) * half,
+					(maxx - minx) * half, (maxy - miny) * half, (maxz - minz) * half);
+
+				return bits(d >= splat(0));
+			}
+
+			const plane_lanes& planes;
+			const vec3_soa& min;
+			const vec3_soa& max;
+		};
+
+		//calls 'visible(i)' for every group of simd lanes in a stream of 'n' objects and writes the bits to 'mask'
+		template <typename F>
+		void write_mask(std::size_t n, F visible, std::uint32_t* mask)
+		{
+			for (std::size_t i = 0; i < n; i += width)
+			{
+				std::uint32_t b = visible(i);
+
+				//the padding lanes past the end of the stream are never visible
+				if (n - i < width)
+					b &= (1u << (n - i)) - 1;
+
+				//'width' divides 32, so a group never straddles two words
+				if (i % 32 == 0)
+					mask[i / 32] = b;
+				else
+					mask[i / 32] |= b << (i % 32);
+			}
+		}
+
+		//calls 'visible(i)' like write_mask() and writes the indices of the visible objects to 'indices'
+		template <typename F>
+		std::size_t write_indices(std::size_t n, F visible, std::uint32_t* indices)
+		{
+			std::size_t count = 0;
+
+			for (std::size_t i = 0; i < n; i += width)
+			{
+				unsigned b = visible(i);
+				std::size_t lanes = std::min<std::size_t>(width, n - i);
+
+				//every index is written, and only kept by advancing 'count' when its object is visible
+				for (std::size_t l = 0; l < lanes; ++l)
+				{
+					indices[count] = (std::uint32_t)(i + l);
+					count += (b >> l) & 1;
+				}
+			}
+
+			return count;
+		}
+
+		void cull_spheres(const frustum& f, const vec3_soa& centers, const float* radii, std::uint32_t* mask)
+		{
+			plane_lanes planes(f);
+			write_mask(centers.size(), spheres_visible{ planes, centers, radii }, mask);
+		}
+
+		std::size_t cull_spheres_compact(const frustum& f, const vec3_soa& centers, const float* radii, std::uint32_t* indices)
+		{
+			plane_lanes planes(f);
+			return write_indices(centers.size(), spheres_visible{ planes, centers, radii }, indices);
+		}
+
+		void cull_aabbs(const frustum& f, const vec3_soa& min, const vec3_soa& max, std::uint32_t* mask)
+		{
+			plane_lanes planes(f);
+			write_mask(min.size(), aabbs_visible{ planes, min, max }, mask);
+		}
+
+		std::size_t cull_aabbs_compact(const frustum& f, const vec3_soa& min, const vec3_soa& max, std::uint32_t* indices)
+		{
+			plane_lanes planes(f);
+			return write_indices(min.size(), aabbs_visible{ planes, min, max }, indices);
+		}
+
+		//PACKED.HPP
+
+#if defined(VECMATH_KERNEL_SSE2)
+		//returns 'a' in the lanes where 'm' is set and 'b' in the others
+		__m128i select_bits(__m128i m, __m128i a, __m128i b)
+		{
+			return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+		}
+
+		//to_half() for 4 floats, with the results sign extended to 32 bits so a saturating pack narrows them
+		__m128i to_half4(__m128 f)
+		{
+			__m128i u = _mm_castps_si128(f);
+			__m128i sign = _mm_and_si128(u, _mm_set1_epi32((int)0x80000000));
+			u = _mm_xor_si128(u, sign);
+
+			__m128i nan = _mm_or_si128(_mm_set1_epi32(0x7e00), _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(0x3ff)));
+			__m128i special = select_bits(_mm_cmpgt_epi32(u, _mm_set1_epi32(0x7f800000)), nan, _mm_set1_epi32(0x7c00));
+
+			__m128 a = _mm_add_ps(_mm_castsi128_ps(u), _mm_set1_ps(0.5f));
+			__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(a), _mm_set1_epi32(0x3f000000));
+
+			__m128i odd = _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(1));
+			__m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(u, _mm_set1_epi32((int)0xc8000fff)), odd), 13);
+
+			__m128i h = select_bits(_mm_cmplt_epi32(u, _mm_set1_epi32(0x38800000)), subnormal, normal);
+			h = select_bits(_mm_cmpgt_epi32(u, _mm_set1_epi32(0x477fffff)), special, h);
+
+			return _mm_or_si128(h, _mm_srai_epi32(sign, 16));
+		}
+
+		//from_half() for 4 halves zero extended to 32 bits
+		__m128 from_half4(__m128i h)
+		{
+			__m128i bits = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+			__m128 f = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(bits, 13)), _mm_set1_ps(0x1p112f));
+
+			__m128i inf = _mm_and_si128(_mm_cmpgt_epi32(bits, _mm_set1_epi32(0x7bff)), _mm_set1_epi32(0x7f800000));
+			__m128i sign = _mm_slli_epi32(_mm_xor_si128(h, bits), 16);
+
+			return _mm_castsi128_ps(_mm_or_si128(_mm_castps_si128(f), _mm_or_si128(inf, sign)));
+		}
+#endif
+
+		//converts 'n' floats to halves, 8 at a time
+		void to_halves(const float* in, std::uint16_t* out, std::size_t n)
+		{
+			std::size_t i = 0;
+
+#if defined(VECMATH_KERNEL_AVX2)
+			for (; i + 8 <= n; i += 8)
+				_mm_storeu_si128((__m128i*)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+#elif defined(VECMATH_KERNEL_SSE2)
+			for (; i + 8 <= n; i += 8)
+				_mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(to_half4(_mm_loadu_ps(in + i)), to_half4(_mm_loadu_ps(in + i + 4))));
+#endif
+
+			for (; i < n; ++i)
+				out[i] = to_half(in[i]);
+		}
+
+		//converts 'n' halves to floats, 8 at a time
+		void from_halves(const std::uint16_t* in, float* out, std::size_t n)
+		{
+			std::size_t i = 0;
+
+#if defined(VECMATH_KERNEL_AVX2)
+			for (; i + 8 <= n; i += 8)
+				_mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+#elif defined(VECMATH_KERNEL_SSE2)
+			for (; i + 8 <= n; i += 8)
+			{
+				__m128i h = _mm_loadu_si128((const __m128i*)(in + i));
+
+				_mm_storeu_ps(out + i, from_half4(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+				_mm_storeu_ps(out + i + 4, from_half4(_mm_unpackhi_epi16(h, _mm_setzero_si128())));
+			}
+#endif
+
+			for (; i < n; ++i)
+				out[i] = from_half(in[i]);
+		}
+
+		void pack_quats(const quat* in, packed_quat* out, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				vfloat x, y, z, w;
+				load4(in[i].m, x, y, z, w);
+
+				//the largest magnitude, preferring w on ties, like pack_quat()
+				vfloat big = abs(w), largest = splat(3);
+
+				vmask m = abs(x) > big;
+				big = select(m, abs(x), big);
+				largest = select(m, splat(0), largest);
+
+				m = abs(y) > big;
+				big = select(m, abs(y), big);
+				largest = select(m, splat(1), largest);
+
+				m = abs(z) > big;
+				largest = select(m, splat(2), largest);
+
+				vmask is0 = largest == splat(0), is1 = largest == splat(1), is3 = largest == splat(3);
+
+				vfloat l = select(is0, x, select(is1, y, select(is3, w, z)));
+				vfloat scale = select(l < splat(0), splat(-detail::quat_snorm), splat(detail::quat_snorm));
+
+				//the other three components in x, y, z, w order
+				vfloat a = select(is0, y, x);
+				vfloat b = select(is0 | is1, z, y);
+				vfloat c = select(is3, z, w);
+
+				vfloat lo = splat(-32767), hi = splat(32767);
+
+				a = round(min(max(a * scale, lo), hi));
+				b = round(min(max(b * scale, lo), hi));
+				c = round(min(max(c * scale, lo), hi));
+
+				float q[4 * width];
+				store4(q, a, b, c, largest);
+
+				for (unsigned j = 0; j < width; ++j)
+					out[i + j] = { (std::int16_t)q[4 * j], (std::int16_t)q[4 * j + 1], (std::int16_t)q[4 * j + 2], (std::uint16_t)q[4 * j + 3] };
+			}
+
+			for (; i < n; ++i)
+				out[i] = pack_quat(in[i]);
+		}
+
+		void unpack_quats(const packed_quat* in, quat* out, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				float q[4 * width];
+
+				for (unsigned j = 0; j < width; ++j)
+				{
+					q[4 * j] = in[i + j].a;
+					q[4 * j + 1] = in[i + j].b;
+					q[4 * j + 2] = in[i + j].c;
+					q[4 * j + 3] = (float)(in[i + j].largest & 3);
+				}
+
+				vfloat a, b, c, largest;
+				load4(q, a, b, c, largest);
+
+				a = a / splat(detail::quat_snorm);
+				b = b / splat(detail::quat_snorm);
+				c = c / splat(detail::quat_snorm);
+
+				vfloat l = sqrt(max(splat(1) - madd(c, c, madd(b, b, a * a)), splat(0)));
+
+				vmask is0 = largest == splat(0), is1 = largest == splat(1), is2 = largest == splat(2), is3 = largest == splat(3);
+
+				vfloat x = select(is0, l, a);
+				vfloat y = select(is0, a, select(is1, l, b));
+				vfloat z = select(is3, c, select(is2, l, b));
+				vfloat w = select(is3, l, c);
+
+				store4(out[i].m, x, y, z, w);
+			}
+
+			for (; i < n; ++i)
+				out[i] = unpack_quat(in[i]);
+		}
+
+		//returns the components of normals, already rounded to integers, as 10:10:10:2 bits
+		std::uint32_t normal_bits(float x, float y, float z, float w)
+		{
+			return (std::uint32_t)((std::int32_t)x & 0x3ff) | (std::uint32_t)((std::int32_t)y & 0x3ff) << 10 |
+			       (std::uint32_t)((std::int32_t)z & 0x3ff) << 20 | (std::uint32_t)((std::int32_t)w & 3) << 30;
+		}
+
+		//returns 'v' clamped to [-1, 1], scaled by 'scale', and rounded
+		vfloat snorm(vfloat v, vfloat scale)
+		{
+			return round(min(max(v, splat(-1)), splat(1)) * scale);
+		}
+
+		//packs normals of 3 (w = 0) or 4 components like pack_normal()
+		//each group is quantized across the lanes, then assembled into bits per element
+		template <unsigned N, typename V>
+		void pack_normals(const V* in, packed_normal* out, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				float q[4 * width];
+				vfloat x, y, z, w = splat(0);
+
+				if (N == 3)
+					load3(in[i].m, x, y, z);
+				else
+					load4(in[i].m, x, y, z, w);
+
+				store4(q, snorm(x, splat(511)), snorm(y, splat(511)), snorm(z, splat(511)), snorm(w, splat(1)));
+
+				for (unsigned j = 0; j < width; ++j)
+					out[i + j].v = normal_bits(q[4 * j], q[4 * j + 1], q[4 * j + 2], q[4 * j + 3]);
+			}
+
+			for (; i < n; ++i)
+				out[i] = pack_normal(in[i]);
+		}
+
+		//unpacks normals to 3 or 4 components like unpack_normal()
+		//each group's fields are sign extended per element, then scaled across the lanes
+		template <unsigned N, typename V>
+		void unpack_normals(const packed_normal* in, V* out, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				float q[4 * width];
+
+				for (unsigned j = 0; j < width; ++j)
+				{
+					std::uint32_t v = in[i + j].v;
+
+					q[4 * j] = (float)((std::int32_t)(v << 22) >> 22);
+					q[4 * j + 1] = (float)((std::int32_t)(v << 12) >> 22);
+					q[4 * j + 2] = (float)((std::int32_t)(v << 2) >> 22);
+					q[4 * j + 3] = (float)((std::int32_t)v >> 30);
+				}
+
+				vfloat x, y, z, w;
+				load4(q, x, y, z, w);
+
+				x = max(x / splat(511), splat(-1));
+				y = max(y / splat(511), splat(-1));
+				z = max(z / splat(511), splat(-1));
+				w = max(w, splat(-1));
+
+				if (N == 3)
+					store3(out[i].m, x, y, z);
+				else
+					store4(out[i].m, x, y, z, w);
+			}
+
+			for (; i < n; ++i)
+				out[i] = V(unpack_normal(in[i]));
+		}
+
+		//SOA.HPP
+		//the stream functions run over whole groups of lanes, reading and writing the zeroed padding
+
+		void split3(const vec3* in, float* x, float* y, float* z, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				vfloat vx, vy, vz;
+				load3(in[i].m, vx, vy, vz);
+
+				store(x + i, vx);
+				store(y + i, vy);
+				store(z + i, vz);
+			}
+
+			for (; i < n; ++i)
+			{
+				x[i] = in[i].x;
+				y[i] = in[i].y;
+				z[i] = in[i].z;
+			}
+		}
+
+		void join3(const float* x, const float* y, const float* z, vec3* out, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+				store3(out[i].m, load(x + i), load(y + i), load(z + i));
+
+			for (; i < n; ++i)
+				out[i] = vec3(x[i], y[i], z[i]);
+		}
+
+		void split4(const quat* in, float* x, float* y, float* z, float* w, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				vfloat qx, qy, qz, qw;
+				load4(in[i].m, qx, qy, qz, qw);
+
+				store(x + i, qx);
+				store(y + i, qy);
+				store(z + i, qz);
+				store(w + i, qw);
+			}
+
+			for (; i < n; ++i)
+			{
+				x[i] = in[i].x;
+				y[i] = in[i].y;
+				z[i] = in[i].z;
+				w[i] = in[i].w;
+			}
+		}
+
+		void join4(const float* x, const float* y, const float* z, const float* w, quat* out, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+				store4(out[i].m, load(x + i), load(y + i), load(z + i), load(w + i));
+
+			for (; i < n; ++i)
+				out[i] = quat(x[i], y[i], z[i], w[i]);
+		}
+
+		//writes 'v' to 'out[i]', for up to 'n' elements
+		void store_scalar(float* out, std::size_t i, std::size_t n, vfloat v)
+		{
+			if (i + width <= n)
+				store(out + i, v);
+			else
+			{
+				float lanes[width];
+				store(lanes, v);
+				std::memcpy(out + i, lanes, (n - i) * sizeof(float));
+			}
+		}
+
+		vfloat normalize_scale(vfloat len)
+		{
+			//zero length vectors are returned unchanged, like normalize(const vec3&)
+			return select(len == splat(0), splat(1), splat(1) / len);
+		}
+
+		void length3(const vec3_soa& v, float* out)
+		{
+			for (std::size_t i = 0; i < v.size(); i += width)
+			{
+				vfloat x = load(v.x + i), y = load(v.y + i), z = load(v.z + i);
+				store_scalar(out, i, v.size(), sqrt(madd(z, z, madd(y, y, x * x))));
+			}
+		}
+
+		void dot3(const vec3_soa& a, const vec3_soa& b, float* out)
+		{
+			for (std::size_t i = 0; i < a.size(); i += width)
+			{
+				vfloat d = madd(load(a.z + i), load(b.z + i), madd(load(a.y + i), load(b.y + i), load(a.x + i) * load(b.x + i)));
+				store_scalar(out, i, a.size(), d);
+			}
+		}
+
+		void normalize3(const vec3_soa& v, vec3_soa& out)
+		{
+			for (std::size_t i = 0; i < v.size(); i += width)
+			{
+				vfloat x = load(v.x + i), y = load(v.y + i), z = load(v.z + i);
+				vfloat s = normalize_scale(sqrt(madd(z, z, madd(y, y, x * x))));
+
+				store(out.x + i, x * s);
+				store(out.y + i, y * s);
+				store(out.z + i, z * s);
+			}
+		}
+
+		void cross3(const vec3_soa& a, const vec3_soa& b, vec3_soa& out)
+		{
+			for (std::size_t i = 0; i < a.size(); i += width)
+			{
+				vfloat ax = load(a.x + i), ay = load(a.y + i), az = load(a.z + i);
+				vfloat bx = load(b.x + i), by = load(b.y + i), bz = load(b.z + i);
+
+				store(out.x + i, ay * bz - az * by);
+				store(out.y + i, az * bx - ax * bz);
+				store(out.z + i, ax * by - ay * bx);
+			}
+		}
+
+		void lerp3(const vec3_soa& a, const vec3_soa& b, float t, vec3_soa& out)
+		{
+			vfloat vt = splat(t);
+
+			for (std::size_t i = 0; i < a.size(); i += width)
+			{
+				vfloat ax = load(a.x + i), ay = load(a.y + i), az = load(a.z + i);
+
+				store(out.x + i, madd(load(b.x + i) - ax, vt, ax));
+				store(out.y + i, madd(load(b.y + i) - ay, vt, ay));
+				store(out.z + i, madd(load(b.z + i) - az, vt, az));
+			}
+		}
+
+		void length4(const quat_soa& q, float* out)
+		{
+			for (std::size_t i = 0; i < q.size(); i += width)
+			{
+				vfloat x = load(q.x + i), y = load(q.y + i), z = load(q.z + i), w = load(q.w + i);
+				store_scalar(out, i, q.size(), sqrt(madd(w, w, madd(z, z, madd(y, y, x * x)))));
+			}
+		}
+
+		void dot4(const quat_soa& a, const quat_soa& b, float* out)
+		{
+			for (std::size_t i = 0; i < a.size(); i += width)
+			{
+				vfloat d = load(a.x + i) * load(b.x + i);
+				d = madd(load(a.y + i), load(b.y + i), d);
+				d = madd(load(a.z + i), load(b.z + i), d);
+				d = madd(load(a.w + i), load(b.w + i), d);
+
+				store_scalar(out, i, a.size(), d);
+			}
+		}
+
+		void normalize4(const quat_soa& q, quat_soa& out)
+		{
+			for (std::size_t i = 0; i < q.size(); i += width)
+			{
+				vfloat x = load(q.x + i), y = load(q.y + i), z = load(q.z + i), w = load(q.w + i);
+				vfloat s = normalize_scale(sqrt(madd(w, w, madd(z, z, madd(y, y, x * x)))));
+
+				store(out.x + i, x * s);
+				store(out.y + i, y * s);
+				store(out.z + i, z * s);
+				store(out.w + i, w * s);
+			}
+		}
+
+		void lerp4(const quat_soa& a, const quat_soa& b, float t, quat_soa& out)
+		{
+			vfloat ta = splat(1.0f - t), tb = splat(t);
+
+			for (std::size_t i = 0; i < a.size(); i += width)
+			{
+				vfloat x = madd(load(b.x + i), tb, load(a.x + i) * ta);
+				vfloat y = madd(load(b.y + i), tb, load(a.y + i) * ta);
+				vfloat z = madd(load(b.z + i), tb, load(a.z + i) * ta);
+				vfloat w = madd(load(b.w + i), tb, load(a.w + i) * ta);
+
+				vfloat s = normalize_scale(sqrt(madd(w, w, madd(z, z, madd(y, y, x * x)))));
+
+				store(out.x + i, x * s);
+				store(out.y + i, y * s);
+				store(out.z + i, z * s);
+				store(out.w + i, w * s);
+			}
+		}
+
+		//SKINNING.HPP
+
+		//loads the 'Count' weights of each lane's vertex, starting at vertex 'i'
+		template <unsigned Count>
+		void load_weights(const float* weights, std::size_t i, vfloat* w)
+		{
+			for (unsigned k = 0; k < Count; k += 4)
+				load4(weights + i * Count + k, Count, w[k], w[k + 1], w[k + 2], w[k + 3]);
+		}
+
+		//points 'p' at the palette entry ('size' floats each) of influence 'k' of each lane's vertex
+		template <unsigned Count>
+		void bone_pointers(const float* palette, std::size_t size, const std::uint16_t* bones, std::size_t i, unsigned k, const float** p)
+		{
+			for (unsigned j = 0; j < width; ++j)
+				p[j] = palette + bones[(i + j) * Count + k] * size;
+		}
+
+		//linear blend skinning with 'Count' influences and a palette with 'Pitch' floats per column
+		//each influence gathers the bone matrices of the lanes with 4 float transposes, like normal_matrices()
+		template <unsigned Count, unsigned Pitch, bool Normals>
+		void skin_linear_lanes(const float* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa* normals, vec3_soa& out_positions, vec3_soa* out_normals, std::size_t begin, std::size_t end)
+		{
+			std::size_t size = 4 * Pitch;
+			std::size_t i = begin;
+
+			for (; i + width <= end; i += width)
+			{
+				vfloat w[Count];
+				load_weights<Count>(influences.weights, i, w);
+
+				//the weighted sum of the bone matrices, three elements per column
+				vfloat m[12];
+
+				for (unsigned k = 0; k < Count; ++k)
+				{
+					const float* p[width];
+					bone_pointers<Count>(palette, size, influences.bones, i, k, p);
+
+					vfloat e[12], unused;
+
+					if (Pitch == 4)
+					{
+						load4(p, 0, e[0], e[1], e[2], unused);
+						load4(p, 4, e[3], e[4], e[5], unused);
+						load4(p, 8, e[6], e[7], e[8], unused);
+						load4(p, 12, e[9], e[10], e[11], unused);
+					}
+					else
+					{
+						load4(p, 0, e[0], e[1], e[2], e[3]);
+						load4(p, 4, e[4], e[5], e[6], e[7]);
+						load4(p, 8, e[8], e[9], e[10], e[11]);
+					}
+
+					for (unsigned c = 0; c < 12; ++c)
+						m[c] = k == 0 ? e[c] * w[0] : madd(e[c], w[k], m[c]);
+				}
+
+				vfloat x = load(positions.x + i), y = load(positions.y + i), z = load(positions.z + i);
+
+				store(out_positions.x + i, madd(m[6], z, madd(m[3], y, madd(m[0], x, m[9]))));
+				store(out_positions.y + i, madd(m[7], z, madd(m[4], y, madd(m[1], x, m[10]))));
+				store(out_positions.z + i, madd(m[8], z, madd(m[5], y, madd(m[2], x, m[11]))));
+
+				if (Normals)
+				{
+					x = load(normals->x + i);
+					y = load(normals->y + i);
+					z = load(normals->z + i);
+
+					vfloat nx = madd(m[6], z, madd(m[3], y, m[0] * x));
+					vfloat ny = madd(m[7], z, madd(m[4], y, m[1] * x));
+					vfloat nz = madd(m[8], z, madd(m[5], y, m[2] * x));
+					vfloat s = normalize_scale(sqrt(madd(nz, nz, madd(ny, ny, nx * nx))));
+
+					store(out_normals->x + i, nx * s);
+					store(out_normals->y + i, ny * s);
+					store(out_normals->z + i, nz * s);
+				}
+			}
+
+			//remaining vertices
+			for (; i < end; ++i)
+			{
+				const std::uint16_t* bones = influences.bones + i * Count;
+				const float* weights = influences.weights + i * Count;
+
+				affine3 a(vec3(0), vec3(0), vec3(0), vec3(0));
+
+				for (unsigned k = 0; k < Count; ++k)
+				{
+					const float* e = palette + bones[k] * size;
+
+					for (unsigned c = 0; c < 4; ++c)
+						a.m[c] += vec3(e[c * Pitch], e[c * Pitch + 1], e[c * Pitch + 2]) * weights[k];
+				}
+
+				vec3 n = Normals ? (*normals)[i] : vec3();
+
+				out_positions[i] = transform_point(a, positions[i]);
+
+				if (Normals)
+					(*out_normals)[i] = vcm::normalize(transform_vector(a, n));
+			}
+		}
+
+		template <unsigned Pitch, bool Normals>
+		void skin_linear_pitched(const float* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa* normals, vec3_soa& out_positions, vec3_soa* out_normals, std::size_t begin, std::size_t end)
+		{
+			if (influences.count == 8)
+				skin_linear_lanes<8, Pitch, Normals>(palette, influences, positions, normals, out_positions, out_normals, begin, end);
+			else
+				skin_linear_lanes<4, Pitch, Normals>(palette, influences, positions, normals, out_positions, out_normals, begin, end);
+		}
+
+		void skin_linear(const float* palette, unsigned pitch, const skin_influences& influences, const vec3_soa& positions, const vec3_soa* normals, vec3_soa& out_positions, vec3_soa* out_normals, std::size_t begin, std::size_t end)
+		{
+			if (pitch == 4)
+			{
+				normals ? skin_linear_pitched<4, true>(palette, influences, positions, normals, out_positions, out_normals, begin, end)
+					: skin_linear_pitched<4, false>(palette, influences, positions, normals, out_positions, out_normals, begin, end);
+			}
+			else
+			{
+				normals ? skin_linear_pitched<3, true>(palette, influences, positions, normals, out_positions, out_normals, begin, end)
+					: skin_linear_pitched<3, false>(palette, influences, positions, normals, out_positions, out_normals, begin, end);
+			}
+		}
+
+		//dual quaternion skinning with 'Count' influences
+		template <unsigned Count, bool Normals>
+		void skin_dual_quat_lanes(const dualquat* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa* normals, vec3_soa& out_positions, vec3_soa* out_normals, std::size_t begin, std::size_t end)
+		{
+			const float* base = palette->real.m;
+			std::size_t i = begin;
+
+			for (; i + width <= end; i += width)
+			{
+				vfloat w[Count];
+				load_weights<Count>(influences.weights, i, w);
+
+				//the weighted sum of the real and dual parts, and the real part of the first influence
+				vfloat r[4], d[4], first[4];
+
+				for (unsigned k = 0; k < Count; ++k)
+				{
+					const float* p[width];
+					bone_pointers<Count>(base, 8, influences.bones, i, k, p);
+
+					vfloat qr[4], qd[4];
+					load4(p, 0, qr[0], qr[1], qr[2], qr[3]);
+					load4(p, 4, qd[0], qd[1], qd[2], qd[3]);
+
+					if (k == 0)
+					{
+						for (unsigned c = 0; c < 4; ++c)
+						{
+							first[c] = qr[c];
+							r[c] = qr[c] * w[0];
+							d[c] = qd[c] * w[0];
+						}
+
+						continue;
+					}
+
+					//q and -q are the same transform; blend the one closer to the first influence
+					vfloat dp = madd(qr[3], first[3], madd(qr[2], first[2], madd(qr[1], first[1], qr[0] * first[0])));
+					vfloat wk = select(dp < splat(0), -w[k], w[k]);
+
+					for (unsigned c = 0; c < 4; ++c)
+					{
+						r[c] = madd(qr[c], wk, r[c]);
+						d[c] = madd(qd[c], wk, d[c]);
+					}
+				}
+
+				vfloat s = normalize_scale(sqrt(madd(r[3], r[3], madd(r[2], r[2], madd(r[1], r[1], r[0] * r[0])))));
+
+				for (unsigned c = 0; c < 4; ++c)
+				{
+					r[c] *= s;
+					d[c] *= s;
+				}
+
+				//the translation, like translation(const dualquat&)
+				vfloat two = splat(2);
+				vfloat tx = (madd(d[0], r[3], -(r[0] * d[3])) + (r[1] * d[2] - r[2] * d[1])) * two;
+				vfloat ty = (madd(d[1], r[3], -(r[1] * d[3])) + (r[2] * d[0] - r[0] * d[2])) * two;
+				vfloat tz = (madd(d[2], r[3], -(r[2] * d[3])) + (r[0] * d[1] - r[1] * d[0])) * two;
+
+				vfloat x = load(positions.x + i), y = load(positions.y + i), z = load(positions.z + i);
+				rotate_lanes(r[0], r[1], r[2], r[3], x, y, z);
+
+				store(out_positions.x + i, x + tx);
+				store(out_positions.y + i, y + ty);
+				store(out_positions.z + i, z + tz);
+
+				if (Normals)
+				{
+					x = load(normals->x + i);
+					y = load(normals->y + i);
+					z = load(normals->z + i);
+
+					rotate_lanes(r[0], r[1], r[2], r[3], x, y, z);
+
+					store(out_normals->x + i, x);
+					store(out_normals->y + i, y);
+					store(out_normals->z + i, z);
+				}
+			}
+
+			//remaining vertices
+			for (; i < end; ++i)
+			{
+				const std::uint16_t* bones = influences.bones + i * Count;
+				const float* weights = influences.weights + i * Count;
+
+				const dualquat& first = palette[bones[0]];
+				dualquat b = first * weights[0];
+
+				for (unsigned k = 1; k < Count; ++k)
+				{
+					const dualquat& q = palette[bones[k]];
+					b += q * (dot(q.real, first.real) < 0 ? -weights[k] : weights[k]);
+				}
+
+				b = vcm::normalize(b);
+
+				vec3 n = Normals ? (*normals)[i] : vec3();
+
+				out_positions[i] = transform_point(b, positions[i]);
+
+				if (Normals)
+					(*out_normals)[i] = transform_vector(b, n);
+			}
+		}
+
+		void skin_dual_quat(const dualquat* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa* normals, vec3_soa& out_positions, vec3_soa* out_normals, std::size_t begin, std::size_t end)
+		{
+			if (influences.count == 8)
+			{
+				normals ? skin_dual_quat_lanes<8, true>(palette, influences, positions, normals, out_positions, out_normals, begin, end)
+					: skin_dual_quat_lanes<8, false>(palette, influences, positions, normals, out_positions, out_normals, begin, end);
+			}
+			else
+			{
+				normals ? skin_dual_quat_lanes<4, true>(palette, influences, positions, normals, out_positions, out_normals, begin, end)
+					: skin_dual_quat_lanes<4, false>(palette, influences, positions, normals, out_positions, out_normals, begin, end);
+			}
+		}
+
+		//BVH.HPP
+
+		//the rays of a packet, one per lane
+		struct ray_lanes
+		{
+			vfloat ox, oy, oz; //origins
+			vfloat dx, dy, dz; //directions
+			vfloat ix, iy, iz; //inverse directions, with zero components replaced like in bvh.cpp
+		};
+
+		//loads the rays 'begin' to 'begin' + width - 1 of the 'n' rays 'rays' into 'r' and their lengths into
+		//'length'; lanes past the end repeat the last ray with a length of -1, which no box or triangle passes
+		void load_rays(const ray* rays, std::size_t begin, std::size_t n, ray_lanes& r, vfloat& length)
+		{
+			float f[10][width];
+
+			for (unsigned j = 0; j < width; ++j)
+			{
+				const ray& a = rays[std::min(begin + j, n - 1)];
+
+				for (unsigned c = 0; c < 3; ++c)
+				{
+					f[c][j] = a.origin[c];
+					f[3 + c][j] = a.direction[c];
+					f[6 + c][j] = 1.0f / (a.direction[c] != 0 ? a.direction[c] : 1e-30f);
+				}
+
+				f[9][j] = begin + j < n ? a.length : -1;
+			}
+
+			r.ox = load(f[0]);
+			r.oy = load(f[1]);
+			r.oz = load(f[2]);
+			r.dx = load(f[3]);
+			r.dy = load(f[4]);
+			r.dz = load(f[5]);
+			r.ix = load(f[6]);
+			r.iy = load(f[7]);
+			r.iz = load(f[8]);
+			length = load(f[9]);
+		}
+
+		//returns the lanes whose rays enter the box from 'min' to 'max' between 0 and 'length', writing where
+		//they enter to 'near'
+		vmask enter_lanes(const vec3& min, const vec3& max, const ray_lanes& r, vfloat length, vfloat& near)
+		{
+			vfloat t0x = (splat(min.x) - r.ox) * r.ix, t1x = (splat(max.x) - r.ox) * r.ix;
+			vfloat t0y = (splat(min.y) - r.oy) * r.iy, t1y = (splat(max.y) - r.oy) * r.iy;
+			vfloat t0z = (splat(min.z) - r.oz) * r.iz, t1z = (splat(max.z) - r.oz) * r.iz;
+
+			near = simd::max(simd::max(simd::min(t0x, t1x), simd::min(t0y, t1y)), simd::max(simd::min(t0z, t1z), splat(0)));
+			vfloat far = simd::min(simd::min(simd::max(t0x, t1x), simd::max(t0y, t1y)), simd::min(simd::max(t0z, t1z), length));
+
+			return near <= far;
+		}
+
+		//returns the lanes whose rays hit the triangle 'a', 'b', 'c' between 0 and 'length', writing the
+		//distance and the barycentric coordinates to 't', 'u', and 'v', like intersect(const ray&, ...)
+		vmask intersect_lanes(const vec3& a, const vec3& b, const vec3& c, const ray_lanes& r, vfloat length, vfloat& t, vfloat& u, vfloat& v)
+		{
+			vec3 e1 = b - a;
+			vec3 e2 = c - a;
+
+			vfloat e1x = splat(e1.x), e1y = splat(e1.y), e1z = splat(e1.z);
+			vfloat e2x = splat(e2.x), e2y = splat(e2.y), e2z = splat(e2.z);
+
+			vfloat px = r.dy * e2z - r.dz * e2y;
+			vfloat py = r.dz * e2x - r.dx * e2z;
+			vfloat pz = r.dx * e2y - r.dy * e2x;
+
+			vfloat det = madd(e1z, pz, madd(e1y, py, e1x * px));
+			vfloat inv = splat(1) / det;
+
+			vfloat sx = r.ox - splat(a.x), sy = r.oy - splat(a.y), sz = r.oz - splat(a.z);
+			u = madd(sz, pz, madd(sy, py, sx * px)) * inv;
+
+			vfloat qx = sy * e1z - sz * e1y;
+			vfloat qy = sz * e1x - sx * e1z;
+			vfloat qz = sx * e1y - sy * e1x;
+
+			v = madd(r.dz, qz, madd(r.dy, qy, r.dx * qx)) * inv;
+			t = madd(e2z, qz, madd(e2y, qy, e2x * qx)) * inv;
+
+			vfloat zero = splat(0);
+			return (abs(det) > zero) & (u >= zero) & (v >= zero) & (u + v <= splat(1)) & (t >= zero) & (t <= length);
+		}
+
+		//traverses the tree with packets of width rays: a node is visited while any lane still enters it
+		//within its closest hit so far (or, for 'Occluded', until it hits anything), and the children are
+		//visited nearest first along the direction of the first ray
+		template <bool Occluded>
+		void trace_rays(const bvh& tree, const ray* rays, ray_hit* hits, std::uint32_t* mask, std::size_t n)
+		{
+			const std::vector<bvh_node>& nodes = tree.nodes();
+			const std::vector<std::uint32_t>& order = tree.primitives();
+			const std::vector<vec3>& triangles = tree.triangles();
+			const std::vector<aabb>& boxes = tree.boxes();
+
+			for (std::size_t i = 0; i < n; i += width)
+			{
+				ray_lanes r;
+				vfloat best_t, best_u = splat(0), best_v = splat(0);
+				std::uint32_t index[width];
+
+				load_rays(rays, i, n, r, best_t);
+
+				for (unsigned j = 0; j < width; ++j)
+					index[j] = ray_hit::none;
+
+				const ray& first = rays[i];
+
+				std::uint32_t stack[bvh::max_depth + 2];
+				unsigned top = 0;
+
+				if (!nodes.empty())
+					stack[top++] = 0;
+
+				while (top > 0)
+				{
+					const bvh_node& node = nodes[stack[--top]];
+
+					vfloat near;
+					if (bits(enter_lanes(node.min, node.max, r, best_t, near)) == 0)
+						continue;
+
+					if (node.count == 0)
+					{
+						const bvh_node& a = nodes[node.first];
+						const bvh_node& b = nodes[node.first + 1];
+
+						//the axis along which the children are furthest apart
+						vec3 apart = (b.min + b.max) - (a.min + a.max);
+						vec3 spread(std::fabs(apart.x), std::fabs(apart.y), std::fabs(apart.z));
+						unsigned axis = spread.x >= spread.y && spread.x >= spread.z ? 0 : spread.y >= spread.z ? 1 : 2;
+
+						//the nearer child is pushed last, so it is visited first
+						bool second_nearer = apart[axis] * first.direction[axis] < 0;
+
+						stack[top++] = second_nearer ? node.first : node.first + 1;
+						stack[top++] = second_nearer ? node.first + 1 : node.first;
+						continue;
+					}
+
+					for (std::uint32_t p = node.first; p < node.first + node.count; ++p)
+					{
+						vfloat t, u = splat(0), v = splat(0);
+						vmask found;
+
+						if (boxes.empty())
+							found = intersect_lanes(triangles[3 * p], triangles[3 * p + 1], triangles[3 * p + 2], r, best_t, t, u, v);
+						else
+							found = enter_lanes(boxes[p].min, boxes[p].max, r, best_t, t);
+
+						unsigned lanes = bits(found);
+						if (lanes == 0)
+							continue;
+
+						if (Occluded)
+						{
+							//the lanes that hit are done
+							for (unsigned j = 0; j < width; ++j)
+							{
+								if (lanes & (1u << j))
+									mask[(i + j) / 32] |= 1u << ((i + j) % 32);
+							}
+
+							best_t = select(found, splat(-1), best_t);
+							continue;
+						}
+
+						best_t = select(found, t, best_t);
+						best_u = select(found, u, best_u);
+						best_v = select(found, v, best_v);
+
+						for (unsigned j = 0; j < width; ++j)
+						{
+							if (lanes & (1u << j))
+								index[j] = order[p];
+						}
+					}
+
+					if (Occluded && bits(best_t >= splat(0)) == 0)
+						break;
+				}
+
+				if (!Occluded)
+				{
+					float t[width], u[width], v[width];
+
+					store(t, best_t);
+					store(u, best_u);
+					store(v, best_v);
+
+					for (unsigned j = 0; j < width && i + j < n; ++j)
+						hits[i + j] = { t[j], u[j], v[j], index[j] };
+				}
+			}
+		}
+
+		void intersect_rays(const bvh& tree, const ray* rays, ray_hit* hits, std::size_t n)
+		{
+			trace_rays<false>(tree, rays, hits, nullptr, n);
+		}
+
+		void occluded_rays(const bvh& tree, const ray* rays, std::uint32_t* mask, std::size_t n)
+		{
+			trace_rays<true>(tree, rays, nullptr, mask, n);
+		}
+
+		//FASTMATH.HPP
+
+		void sincos_fast(const float* x, float* s, float* c, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				vfloat vs, vc;
+				sincos(load(x + i), vs, vc);
+
+				store(s + i, vs);
+				store(c + i, vc);
+			}
+
+			if (i < n)
+			{
+				float tail[width] = {}, ts[width], tc[width];
+				std::copy(x + i, x + n, tail);
+
+				vfloat vs, vc;
+				sincos(load(tail), vs, vc);
+
+				store(ts, vs);
+				store(tc, vc);
+
+				std::copy(ts, ts + (n - i), s + i);
+				std::copy(tc, tc + (n - i), c + i);
+			}
+		}
+
+		void normalize3_fast(const vec3_soa& v, vec3_soa& out)
+		{
+			for (std::size_t i = 0; i < v.size(); i += width)
+			{
+				vfloat x = load(v.x + i), y = load(v.y + i), z = load(v.z + i);
+				vfloat len2 = madd(z, z, madd(y, y, x * x));
+				vfloat s = select(len2 == splat(0), splat(1), rsqrt(len2));
+
+				store(out.x + i, x * s);
+				store(out.y + i, y * s);
+				store(out.z + i, z * s);
+			}
+		}
+
+		//POINTSTREAM.HPP
+
+		//transforms the points like transform_points() and returns the box around the results
+		//the last points are padded to a full vector with copies of the first of them, so each point comes out
+		//the same wherever the arrays are split into chunks or across threads
+		//the new point is the first operand of min and max, so points with nan components are left out
+		aabb transform_points_bounds(const mat4& m, const vec3* in, vec3* out, std::size_t n)
+		{
+			vfloat m00 = splat(m[0][0]), m01 = splat(m[0][1]), m02 = splat(m[0][2]);
+			vfloat m10 = splat(m[1][0]), m11 = splat(m[1][1]), m12 = splat(m[1][2]);
+			vfloat m20 = splat(m[2][0]), m21 = splat(m[2][1]), m22 = splat(m[2][2]);
+			vfloat m30 = splat(m[3][0]), m31 = splat(m[3][1]), m32 = splat(m[3][2]);
+
+			aabb result;
+			vfloat lx = splat(result.min.x), ly = splat(result.min.y), lz = splat(result.min.z);
+			vfloat hx = splat(result.max.x), hy = splat(result.max.y), hz = splat(result.max.z);
+
+			vec3 tail[width];
+
+			for (std::size_t i = 0; i < n; i += width)
+			{
+				std::size_t count = n - i < width ? n - i : width;
+				const vec3* src = in + i;
+
+				if (count < width)
+				{
+					for (std::size_t j = 0; j < width; ++j)
+						tail[j] = in[i + (j < count ? j : 0)];
+
+					src = tail;
+				}
+
+				vfloat x, y, z;
+				load3(src->m, x, y, z);
+
+				//in the order of transform3()
+				vfloat rx = madd(m20, z, madd(m10, y, m00 * x)) + m30;
+				vfloat ry = madd(m21, z, madd(m11, y, m01 * x)) + m31;
+				vfloat rz = madd(m22, z, madd(m12, y, m02 * x)) + m32;
+
+				lx = min(rx, lx);
+				ly = min(ry, ly);
+				lz = min(rz, lz);
+				hx = max(rx, hx);
+				hy = max(ry, hy);
+				hz = max(rz, hz);
+
+				if (count < width)
+				{
+					store3(tail[0].m, rx, ry, rz);
+
+					for (std::size_t j = 0; j < count; ++j)
+						out[i + j] = tail[j];
+				}
+				else
+				{
+					store3(out[i].m, rx, ry, rz);
+				}
+			}
+
+			float l[3][width], h[3][width];
+			store(l[0], lx);
+			store(l[1], ly);
+			store(l[2], lz);
+			store(h[0], hx);
+			store(h[1], hy);
+			store(h[2], hz);
+
+			for (unsigned j = 0; j < width; ++j)
+			{
+				for (unsigned k = 0; k < 3; ++k)
+				{
+					result.min[k] = l[k][j] < result.min[k] ? l[k][j] : result.min[k];
+					result.max[k] = h[k][j] > result.max[k] ? h[k][j] : result.max[k];
+				}
+			}
+
+			return result;
+		}
+
+		//defined in here, since the kernels share their names with the public functions
+		constexpr kernel_table table =
+		{
+			transform_points,
+			transform_vectors,
+			transform_aabbs,
+			multiply,
+			normal_matrices,
+			compose,
+			compose_soa,
+			slerp,
+			slerp_array,
+			nlerp,
+			nlerp_array,
+			rotate,
+			rotate_soa,
+
+			cull_spheres,
+			cull_spheres_compact,
+			cull_aabbs,
+			cull_aabbs_compact,
+
+			to_halves,
+			from_halves,
+			pack_quats,
+			unpack_quats,
+			pack_normals<3, vec3>,
+			pack_normals<4, vec4>,
+			unpack_normals<3, vec3>,
+			unpack_normals<4, vec4>,
+
+			split3,
+			join3,
+			split4,
+			join4,
+			length3,
+			dot3,
+			normalize3,
+			cross3,
+			lerp3,
+			length4,
+			dot4,
+			normalize4,
+			lerp4,
+
+			skin_linear,
+			skin_dual_quat,
+
+			intersect_rays,
+			occluded_rays,
+
+			sincos_fast,
+			normalize3_fast,
+
+			transform_points_bounds
+		};
+	}
+
+	const kernel_table VECMATH_KERNEL_TABLE = table;
+}
+
+#if defined(__clang__)
+	#if defined(VECMATH_KERNEL_AVX2) || defined(VECMATH_KERNEL_SSE2)
+		#pragma clang attribute pop
+	#endif
+#elif defined(__GNUC__)
+	#pragma GCC pop_options
+#endif
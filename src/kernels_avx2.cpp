@@ -0,0 +1,13 @@
+//the array kernels for AVX2, FMA and F16C, 8 lanes (backend::avx2)
+//compiled for those instructions whatever the build flags, and only called on cpus that have them
+
+#include "kernels.hpp"
+
+#if defined(VECMATH_KERNELS_AVX2)
+
+#define VECMATH_KERNEL_AVX2
+#define VECMATH_KERNEL_TABLE avx2_kernels
+
+#include "kernels.inl"
+
+#endif
@@ -0,0 +1,6 @@
+//the array kernels without simd, for any cpu (backend::scalar)
+
+#define VECMATH_KERNEL_SCALAR
+#define VECMATH_KERNEL_TABLE scalar_kernels
+
+#include "kernels.inl"
@@ -0,0 +1,12 @@
+//the array kernels for SSE2, 4 lanes (backend::sse2)
+
+#include "kernels.hpp"
+
+#if defined(VECMATH_KERNELS_SSE2)
+
+#define VECMATH_KERNEL_SSE2
+#define VECMATH_KERNEL_TABLE sse2_kernels
+
+#include "kernels.inl"
+
+#endif
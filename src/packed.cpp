@@ -0,0 +1,65 @@
+#include <vecmath/packed.hpp>
+
+#ifndef VECMATH_HEADER_ONLY
+#include <vecmath/packed.inl>
+#endif
+
+#include "kernels.hpp"
+
+namespace vcm
+{
+	static_assert(sizeof(half3) == 3 * sizeof(std::uint16_t), "half3 arrays must be tightly packed");
+	static_assert(sizeof(half4) == 4 * sizeof(std::uint16_t), "half4 arrays must be tightly packed");
+	static_assert(sizeof(packed_quat) == 8, "packed_quat arrays must be tightly packed");
+	static_assert(sizeof(packed_normal) == 4, "packed_normal arrays must be tightly packed");
+
+	void pack_halves(const vec3* in, half3* out, std::size_t n)
+	{
+		kernels().to_halves((const float*)in, (std::uint16_t*)out, 3 * n);
+	}
+
+	void pack_halves(const vec4* in, half4* out, std::size_t n)
+	{
+		kernels().to_halves((const float*)in, (std::uint16_t*)out, 4 * n);
+	}
+
+	void unpack_halves(const half3* in, vec3* out, std::size_t n)
+	{
+		kernels().from_halves((const std::uint16_t*)in, (float*)out, 3 * n);
+	}
+
+	void unpack_halves(const half4* in, vec4* out, std::size_t n)
+	{
+		kernels().from_halves((const std::uint16_t*)in, (float*)out, 4 * n);
+	}
+
+	void pack_quats(const quat* in, packed_quat* out, std::size_t n)
+	{
+		kernels().pack_quats(in, out, n);
+	}
+
+	void unpack_quats(const packed_quat* in, quat* out, std::size_t n)
+	{
+		kernels().unpack_quats(in, out, n);
+	}
+
+	void pack_normals(const vec3* in, packed_normal* out, std::size_t n)
+	{
+		kernels().pack_normals3(in, out, n);
+	}
+
+	void pack_normals(const vec4* in, packed_normal* out, std::size_t n)
+	{
+		kernels().pack_normals4(in, out, n);
+	}
+
+	void unpack_normals(const packed_normal* in, vec3* out, std::size_t n)
+	{
+		kernels().unpack_normals3(in, out, n);
+	}
+
+	void unpack_normals(const packed_normal* in, vec4* out, std::size_t n)
+	{
+		kernels().unpack_normals4(in, out, n);
+	}
+}
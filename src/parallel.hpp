@@ -0,0 +1,57 @@
+#ifndef VECMATH_PARALLEL_H
+#define VECMATH_PARALLEL_H
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+//private to the library: splits array work across threads
+
+namespace vcm
+{
+	namespace parallel
+	{
+		//returns the number of threads to use for a request of 'threads' (0 means one per hardware thread)
+		inline unsigned thread_count(unsigned threads)
+		{
+			if (threads == 0)
+				threads = std::thread::hardware_concurrency();
+
+			return threads == 0 ? 1 : threads;
+		}
+
+		//splits [0, n) into up to 'threads' ranges of at least 'grain' elements and calls f(begin, end)
+		//for each, one of them on the calling thread; range boundaries are multiples of 16 elements
+		template <typename F>
+		void for_ranges(std::size_t n, unsigned threads, std::size_t grain, F f)
+		{
+			std::size_t ranges = thread_count(threads);
+			std::size_t most = grain == 0 ? n : n / grain;
+
+			if (ranges > most)
+				ranges = most;
+
+			if (ranges <= 1)
+			{
+				f((std::size_t)0, n);
+				return;
+			}
+
+			std::size_t step = (n / ranges + 15) / 16 * 16;
+			std::vector<std::thread> workers;
+
+			for (std::size_t begin = step; begin < n; begin += step)
+			{
+				std::size_t end = begin + step < n ? begin + step : n;
+				workers.emplace_back(f, begin, end);
+			}
+
+			f((std::size_t)0, step < n ? step : n);
+
+			for (auto& w : workers)
+				w.join();
+		}
+	}
+}
+
+#endif
@@ -1,8 +0,0 @@
-#include <vecmath/pi.hpp>
-
-namespace vcm 
-{
-	const float PI = 3.14159265359f;
-	const float RAD = PI / 180.0f;
-	const float DEG = 180.0f / PI;
-}
\ No newline at end of file
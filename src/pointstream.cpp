@@ -0,0 +1,162 @@
+#include <vecmath/pointstream.hpp>
+
+#include "kernels.hpp"
+#include "parallel.hpp"
+
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace vcm
+{
+	namespace
+	{
+		//points per thread below which the transforms don't start more threads
+		const std::size_t stream_grain = 16384;
+
+		//reads up to 'n' whole points into 'points' and returns how many were read
+		std::size_t read_points(std::FILE* file, vec3* points, std::size_t n)
+		{
+			return std::fread(points, sizeof(vec3), n, file);
+		}
+
+		bool write_points(std::FILE* file, const vec3* points, std::size_t n)
+		{
+			return std::fwrite(points, sizeof(vec3), n, file) == n;
+		}
+
+		//moves to byte 'offset' of 'file', past the 2 GiB that fseek() can reach
+		bool seek(std::FILE* file, std::uint64_t offset)
+		{
+			if (offset == 0)
+				return true;
+
+#if defined(_WIN32)
+			return _fseeki64(file, (long long)offset, SEEK_SET) == 0;
+#else
+			return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+		}
+
+		//waits for the write of the previous chunk, if any, and returns whether it succeeded
+		bool finish(std::future<bool>& written)
+		{
+			return !written.valid() || written.get();
+		}
+	}
+
+	aabb transform_points_bounds(const mat4& m, const vec3* in, vec3* out, std::size_t n, unsigned threads)
+	{
+		const kernel_table& k = kernels();
+
+		aabb result;
+		std::mutex lock;
+
+		parallel::for_ranges(n, threads, stream_grain, [&](std::size_t begin, std::size_t end)
+		{
+			aabb box = k.transform_points_bounds(m, in + begin, out + begin, end - begin);
+
+			std::lock_guard<std::mutex> guard(lock);
+			result = merge(result, box);
+		});
+
+		return result;
+	}
+
+	bool transform_point_file(const mat4& m, const char* in_path, const char* out_path, aabb& bounds, const point_stream_options& options)
+	{
+		bounds = aabb();
+
+		std::FILE* in = std::fopen(in_path, "rb");
+
+		if (!in)
+			return false;
+
+		std::FILE* out = std::fopen(out_path, "wb");
+
+		if (!out)
+		{
+			std::fclose(in);
+			return false;
+		}
+
+		std::size_t chunk = options.chunk > 0 ? options.chunk : 1;
+		bool ok = seek(in, options.offset);
+
+		if (ok)
+		{
+			//chunk i is transformed in buffers[i % 3] while chunk i + 1 is read into the next buffer and
+			//chunk i - 1 written from the one after it
+			std::vector<vec3> buffers[3];
+
+			for (auto& b : buffers)
+				b.resize(chunk);
+
+			std::future<bool> written;
+			std::size_t count = read_points(in, buffers[0].data(), chunk);
+
+			for (std::size_t i = 0; count > 0; ++i)
+			{
+				vec3* points = buffers[i % 3].data();
+				std::future<std::size_t> read;
+
+				//a short chunk ended the file (or failed, which ferror() tells below)
+				if (count == chunk)
+					read = std::async(std::launch::async, read_points, in, buffers[(i + 1) % 3].data(), chunk);
+
+				bounds = merge(bounds, transform_points_bounds(m, points, points, count, options.threads));
+
+				ok = finish(written);
+				written = std::async(std::launch::async, write_points, out, (const vec3*)points, count);
+
+				count = read.valid() ? read.get() : 0;
+
+				if (!ok)
+					break;
+			}
+
+			ok = finish(written) && ok;
+			ok = !std::ferror(in) && ok;
+		}
+
+		std::fclose(in);
+		return (std::fclose(out) == 0) && ok;
+	}
+
+	bool transform_point_file(const mat4& m, const vec3* in, std::uint64_t n, const char* out_path, aabb& bounds, const point_stream_options& options)
+	{
+		bounds = aabb();
+
+		std::FILE* out = std::fopen(out_path, "wb");
+
+		if (!out)
+			return false;
+
+		std::size_t chunk = options.chunk > 0 ? options.chunk : 1;
+		bool ok = true;
+
+		//chunk i is transformed into buffers[i % 2] while chunk i - 1 is written from the other one
+		std::vector<vec3> buffers[2];
+
+		for (auto& b : buffers)
+			b.resize(n < chunk ? (std::size_t)n : chunk);
+
+		std::future<bool> written;
+
+		for (std::uint64_t begin = 0, i = 0; begin < n && ok; begin += chunk, ++i)
+		{
+			std::size_t count = n - begin < chunk ? (std::size_t)(n - begin) : chunk;
+			vec3* points = buffers[i % 2].data();
+
+			bounds = merge(bounds, transform_points_bounds(m, in + begin, points, count, options.threads));
+
+			ok = finish(written);
+			written = std::async(std::launch::async, write_points, out, (const vec3*)points, count);
+		}
+
+		ok = finish(written) && ok;
+
+		return (std::fclose(out) == 0) && ok;
+	}
+}
@@ -0,0 +1,73 @@
+#include <vecmath/skinning.hpp>
+
+#include "kernels.hpp"
+#include "parallel.hpp"
+
+namespace vcm
+{
+	namespace
+	{
+		//vertices per thread below which skinning doesn't start more threads
+		const std::size_t skin_grain = 4096;
+
+		void skin_linear(const float* palette, unsigned pitch, const skin_influences& influences, const vec3_soa& positions, const vec3_soa* normals, vec3_soa& out_positions, vec3_soa* out_normals, unsigned threads)
+		{
+			const kernel_table& k = kernels();
+
+			out_positions.resize(positions.size());
+
+			if (out_normals)
+				out_normals->resize(positions.size());
+
+			parallel::for_ranges(positions.size(), threads, skin_grain, [&](std::size_t begin, std::size_t end)
+			{
+				k.skin_linear(palette, pitch, influences, positions, normals, out_positions, out_normals, begin, end);
+			});
+		}
+
+		void skin_dual_quat(const dualquat* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa* normals, vec3_soa& out_positions, vec3_soa* out_normals, unsigned threads)
+		{
+			const kernel_table& k = kernels();
+
+			out_positions.resize(positions.size());
+
+			if (out_normals)
+				out_normals->resize(positions.size());
+
+			parallel::for_ranges(positions.size(), threads, skin_grain, [&](std::size_t begin, std::size_t end)
+			{
+				k.skin_dual_quat(palette, influences, positions, normals, out_positions, out_normals, begin, end);
+			});
+		}
+	}
+
+	void skin_linear(const mat4* palette, const skin_influences& influences, const vec3_soa& positions, vec3_soa& out_positions, unsigned threads)
+	{
+		skin_linear((const float*)palette, 4, influences, positions, nullptr, out_positions, nullptr, threads);
+	}
+
+	void skin_linear(const mat4* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa& normals, vec3_soa& out_positions, vec3_soa& out_normals, unsigned threads)
+	{
+		skin_linear((const float*)palette, 4, influences, positions, &normals, out_positions, &out_normals, threads);
+	}
+
+	void skin_linear(const affine3* palette, const skin_influences& influences, const vec3_soa& positions, vec3_soa& out_positions, unsigned threads)
+	{
+		skin_linear((const float*)palette, 3, influences, positions, nullptr, out_positions, nullptr, threads);
+	}
+
+	void skin_linear(const affine3* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa& normals, vec3_soa& out_positions, vec3_soa& out_normals, unsigned threads)
+	{
+		skin_linear((const float*)palette, 3, influences, positions, &normals, out_positions, &out_normals, threads);
+	}
+
+	void skin_dual_quat(const dualquat* palette, const skin_influences& influences, const vec3_soa& positions, vec3_soa& out_positions, unsigned threads)
+	{
+		skin_dual_quat(palette, influences, positions, nullptr, out_positions, nullptr, threads);
+	}
+
+	void skin_dual_quat(const dualquat* palette, const skin_influences& influences, const vec3_soa& positions, const vec3_soa& normals, vec3_soa& out_positions, vec3_soa& out_normals, unsigned threads)
+	{
+		skin_dual_quat(palette, influences, positions, &normals, out_positions, &out_normals, threads);
+	}
+}
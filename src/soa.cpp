@@ -0,0 +1,322 @@
+#include <vecmath/soa.hpp>
+
+#include "kernels.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace vcm
+{
+	namespace
+	{
+		const std::size_t soa_align = 64;
+		const std::size_t soa_pad = 16;
+
+		//returns 'n' rounded up to a whole number of padded blocks
+		std::size_t padded(std::size_t n)
+		{
+			return (n + soa_pad - 1) / soa_pad * soa_pad;
+		}
+
+		//returns 'floats' zeroed floats aligned to soa_align bytes
+		//the distance to the start of the real allocation is stored in the byte before the result
+		float* allocate(std::size_t floats)
+		{
+			if (floats == 0)
+				return nullptr;
+
+			unsigned char* raw = new unsigned char[floats * sizeof(float) + soa_align];
+			std::size_t offset = soa_align - (reinterpret_cast<std::uintptr_t>(raw) % soa_align);
+
+			unsigned char* result = raw + offset;
+			result[-1] = (unsigned char)offset;
+
+			std::memset(result, 0, floats * sizeof(float));
+			return reinterpret_cast<float*>(result);
+		}
+
+		void release(float* p)
+		{
+			if (!p)
+				return;
+
+			unsigned char* result = reinterpret_cast<unsigned char*>(p);
+			delete[] (result - result[-1]);
+		}
+	}
+
+	//VEC3_SOA
+
+	vec3_soa::vec3_soa() : x(nullptr), y(nullptr), z(nullptr), count(0), capacity(0) {}
+
+	vec3_soa::vec3_soa(std::size_t n) : vec3_soa()
+	{
+		resize(n);
+	}
+
+	vec3_soa::vec3_soa(const vec3* v, std::size_t n) : vec3_soa()
+	{
+		assign(v, n);
+	}
+
+	vec3_soa::vec3_soa(const vec3_soa& other) : vec3_soa()
+	{
+		*this = other;
+	}
+
+	vec3_soa::vec3_soa(vec3_soa&& other) : vec3_soa()
+	{
+		*this = std::move(other);
+	}
+
+	vec3_soa::~vec3_soa()
+	{
+		release(x);
+	}
+
+	vec3_soa& vec3_soa::operator=(const vec3_soa& other)
+	{
+		if (this == &other)
+			return *this;
+
+		resize(0);
+		resize(other.count);
+
+		if (count > 0)
+		{
+			std::memcpy(x, other.x, count * sizeof(float));
+			std::memcpy(y, other.y, count * sizeof(float));
+			std::memcpy(z, other.z, count * sizeof(float));
+		}
+
+		return *this;
+	}
+
+	vec3_soa& vec3_soa::operator=(vec3_soa&& other)
+	{
+		std::swap(x, other.x);
+		std::swap(y, other.y);
+		std::swap(z, other.z);
+		std::swap(count, other.count);
+		std::swap(capacity, other.capacity);
+
+		return *this;
+	}
+
+	void vec3_soa::resize(std::size_t n)
+	{
+		if (n < count)
+		{
+			//everything past the end is kept zeroed
+			std::memset(x + n, 0, (count - n) * sizeof(float));
+			std::memset(y + n, 0, (count - n) * sizeof(float));
+			std::memset(z + n, 0, (count - n) * sizeof(float));
+		}
+		else if (n > capacity)
+		{
+			std::size_t cap = padded(n);
+			float* block = allocate(cap * 3);
+
+			if (count > 0)
+			{
+				std::memcpy(block, x, count * sizeof(float));
+				std::memcpy(block + cap, y, count * sizeof(float));
+				std::memcpy(block + cap * 2, z, count * sizeof(float));
+			}
+
+			release(x);
+
+			x = block;
+			y = block + cap;
+			z = block + cap * 2;
+			capacity = cap;
+		}
+
+		count = n;
+	}
+
+	void vec3_soa::assign(const vec3* v, std::size_t n)
+	{
+		resize(n);
+		kernels().split3(v, x, y, z, n);
+	}
+
+	void vec3_soa::store(vec3* out) const
+	{
+		kernels().join3(x, y, z, out, count);
+	}
+
+	//QUAT_SOA
+
+	quat_soa::quat_soa() : x(nullptr), y(nullptr), z(nullptr), w(nullptr), count(0), capacity(0) {}
+
+	quat_soa::quat_soa(std::size_t n) : quat_soa()
+	{
+		resize(n);
+	}
+
+	quat_soa::quat_soa(const quat* q, std::size_t n) : quat_soa()
+	{
+		assign(q, n);
+	}
+
+	quat_soa::quat_soa(const quat_soa& other) : quat_soa()
+	{
+		*this = other;
+	}
+
+	quat_soa::quat_soa(quat_soa&& other) : quat_soa()
+	{
+		*this = std::move(other);
+	}
+
+	quat_soa::~quat_soa()
+	{
+		release(x);
+	}
+
+	quat_soa& quat_soa::operator=(const quat_soa& other)
+	{
+		if (this == &other)
+			return *this;
+
+		resize(0);
+		resize(other.count);
+
+		if (count > 0)
+		{
+			std::memcpy(x, other.x, count * sizeof(float));
+			std::memcpy(y, other.y, count * sizeof(float));
+			std::memcpy(z, other.z, count * sizeof(float));
+			std::memcpy(w, other.w, count * sizeof(float));
+		}
+
+		return *this;
+	}
+
+	quat_soa& quat_soa::operator=(quat_soa&& other)
+	{
+		std::swap(x, other.x);
+		std::swap(y, other.y);
+		std::swap(z, other.z);
+		std::swap(w, other.w);
+		std::swap(count, other.count);
+		std::swap(capacity, other.capacity);
+
+		return *this;
+	}
+
+	void quat_soa::resize(std::size_t n)
+	{
+		if (n < count)
+		{
+			//everything past the end is kept zeroed
+			std::memset(x + n, 0, (count - n) * sizeof(float));
+			std::memset(y + n, 0, (count - n) * sizeof(float));
+			std::memset(z + n, 0, (count - n) * sizeof(float));
+			std::memset(w + n, 0, (count - n) * sizeof(float));
+		}
+		else if (n > capacity)
+		{
+			std::size_t cap = padded(n);
+			float* block = allocate(cap * 4);
+
+			if (count > 0)
+			{
+				std::memcpy(block, x, count * sizeof(float));
+				std::memcpy(block + cap, y, count * sizeof(float));
+				std::memcpy(block + cap * 2, z, count * sizeof(float));
+				std::memcpy(block + cap * 3, w, count * sizeof(float));
+			}
+
+			release(x);
+
+			x = block;
+			y = block + cap;
+			z = block + cap * 2;
+			w = block + cap * 3;
+			capacity = cap;
+		}
+
+		for (std::size_t i = count; i < n; ++i)
+			w[i] = 1;
+
+		count = n;
+	}
+
+	void quat_soa::assign(const quat* q, std::size_t n)
+	{
+		resize(n);
+		kernels().split4(q, x, y, z, w, n);
+	}
+
+	void quat_soa::store(quat* out) const
+	{
+		kernels().join4(x, y, z, w, out, count);
+	}
+
+	//STREAM FUNCTIONS
+
+	void length(const vec3_soa& v, float* out)
+	{
+		kernels().length3(v, out);
+	}
+
+	void dot(const vec3_soa& a, const vec3_soa& b, float* out)
+	{
+		kernels().dot3(a, b, out);
+	}
+
+	void normalize(const vec3_soa& v, vec3_soa& out)
+	{
+		out.resize(v.size());
+		kernels().normalize3(v, out);
+	}
+
+	void cross(const vec3_soa& a, const vec3_soa& b, vec3_soa& out)
+	{
+		out.resize(a.size());
+		kernels().cross3(a, b, out);
+	}
+
+	void lerp(const vec3_soa& a, const vec3_soa& b, float t, vec3_soa& out)
+	{
+		out.resize(a.size());
+		kernels().lerp3(a, b, t, out);
+	}
+
+	void length(const quat_soa& q, float* out)
+	{
+		kernels().length4(q, out);
+	}
+
+	void dot(const quat_soa& a, const quat_soa& b, float* out)
+	{
+		kernels().dot4(a, b, out);
+	}
+
+	void normalize(const quat_soa& q, quat_soa& out)
+	{
+		out.resize(q.size());
+		kernels().normalize4(q, out);
+	}
+
+	void lerp(const quat_soa& a, const quat_soa& b, float t, quat_soa& out)
+	{
+		out.resize(a.size());
+		kernels().lerp4(a, b, t, out);
+	}
+
+	void rotate(const quat_soa& q, const vec3_soa& v, vec3_soa& out)
+	{
+		out.resize(v.size());
+		kernels().rotate_soa(q, v, out, false);
+	}
+
+	void inverse_rotate(const quat_soa& q, const vec3_soa& v, vec3_soa& out)
+	{
+		out.resize(v.size());
+		kernels().rotate_soa(q, v, out, true);
+	}
+}
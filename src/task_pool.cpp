@@ -0,0 +1,130 @@
+#include "task_pool.hpp"
+
+#include "parallel.hpp"
+
+namespace vcm
+{
+	task_pool::task_pool(unsigned threads) :
+		count(parallel::thread_count(threads)),
+		queues(new queue[count]),
+		job(nullptr),
+		remaining(0),
+		generation(0),
+		stopping(false)
+	{
+		//queue 0 belongs to the thread calling run()
+		for (unsigned i = 1; i < count; ++i)
+			this->threads.emplace_back(&task_pool::loop, this, i);
+	}
+
+	task_pool::~task_pool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			stopping = true;
+		}
+
+		wake.notify_all();
+
+		for (auto& t : threads)
+			t.join();
+	}
+
+	void task_pool::run(std::size_t tasks, const std::function<void(std::size_t)>& f)
+	{
+		if (count == 1 || tasks <= 1)
+		{
+			for (std::size_t i = 0; i < tasks; ++i)
+				f(i);
+
+			return;
+		}
+
+		job = &f;
+		remaining = tasks;
+
+		for (std::size_t i = 0; i < tasks; ++i)
+		{
+			queue& q = queues[i % count];
+			std::lock_guard<std::mutex> guard(q.lock);
+			q.tasks.push_back(i);
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			++generation;
+		}
+
+		wake.notify_all();
+		work(0);
+
+		std::unique_lock<std::mutex> guard(lock);
+		done.wait(guard, [this] { return remaining == 0; });
+	}
+
+	bool task_pool::next(unsigned self, std::size_t& task)
+	{
+		{
+			queue& q = queues[self];
+			std::lock_guard<std::mutex> guard(q.lock);
+
+			if (!q.tasks.empty())
+			{
+				task = q.tasks.back();
+				q.tasks.pop_back();
+				return true;
+			}
+		}
+
+		for (unsigned i = 1; i < count; ++i)
+		{
+			queue& q = queues[(self + i) % count];
+			std::lock_guard<std::mutex> guard(q.lock);
+
+			if (!q.tasks.empty())
+			{
+				task = q.tasks.front();
+				q.tasks.pop_front();
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void task_pool::work(unsigned self)
+	{
+		std::size_t task;
+
+		while (next(self, task))
+		{
+			(*job)(task);
+
+			if (--remaining == 0)
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				done.notify_all();
+			}
+		}
+	}
+
+	void task_pool::loop(unsigned self)
+	{
+		std::size_t seen = 0;
+
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				wake.wait(guard, [&] { return stopping || generation != seen; });
+
+				if (stopping)
+					return;
+
+				seen = generation;
+			}
+
+			work(self);
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef VECMATH_TASK_POOL_H
+#define VECMATH_TASK_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//private to the library: a persistent work-stealing thread pool
+
+namespace vcm
+{
+	class task_pool
+	{
+	public:
+		//creates a pool of 'threads' threads, the calling thread included (0 means one per hardware thread)
+		explicit task_pool(unsigned threads);
+		~task_pool();
+
+		task_pool(const task_pool&) = delete;
+		task_pool& operator=(const task_pool&) = delete;
+
+		//returns the number of threads in the pool, the calling thread included
+		unsigned size() const { return count; }
+
+		//calls f(i) for every i in [0, tasks) on the pool's threads and returns once every call finished
+		//tasks are dealt out round-robin, and threads that run out steal from the others
+		void run(std::size_t tasks, const std::function<void(std::size_t)>& f);
+
+	private:
+		struct queue
+		{
+			std::mutex lock;
+			std::deque<std::size_t> tasks;
+		};
+
+		//takes a task from the back of the queue of 'self', or steals one from the front of another queue
+		bool next(unsigned self, std::size_t& task);
+
+		//runs tasks until every queue is empty
+		void work(unsigned self);
+
+		//worker thread main loop
+		void loop(unsigned self);
+
+		unsigned count;
+		std::unique_ptr<queue[]> queues;
+		std::vector<std::thread> threads;
+
+		std::mutex lock;
+		std::condition_variable wake;
+		std::condition_variable done;
+
+		const std::function<void(std::size_t)>* job;
+		std::atomic<std::size_t> remaining;
+		std::size_t generation;
+		bool stopping;
+	};
+}
+
+#endif
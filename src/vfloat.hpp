@@ -0,0 +1,495 @@
+#ifndef VECMATH_VFLOAT_H
+#define VECMATH_VFLOAT_H
+
+#include <cmath>
+#include <cstddef>
+
+//private to the library: a float vector as wide as the instruction set of the including kernel source
+//(8 lanes with AVX2, 4 with SSE2, 1 for the scalar code) so array kernels are written once
+
+#if defined(VECMATH_KERNEL_AVX2)
+	#include <immintrin.h>
+	#define VECMATH_KERNEL_ISA avx2
+#elif defined(VECMATH_KERNEL_SSE2)
+	#include <emmintrin.h>
+	#define VECMATH_KERNEL_ISA sse2
+#elif defined(VECMATH_KERNEL_SCALAR)
+	#define VECMATH_KERNEL_ISA scalar
+#else
+	#error "vfloat.hpp is only for the kernel sources, which select an instruction set"
+#endif
+
+namespace vcm
+{
+	namespace simd
+	{
+	//each instruction set gets its own namespace, so the inline functions of the kernel sources have
+	//different names and the linker never picks an avx2 definition for the code of another backend
+	inline namespace VECMATH_KERNEL_ISA
+	{
+#if defined(VECMATH_KERNEL_AVX2)
+		const unsigned width = 8;
+
+		struct vfloat { __m256 v; };
+		struct vmask { __m256 v; };
+
+		inline vfloat load(const float* p) { return { _mm256_loadu_ps(p) }; }
+		inline void store(float* p, vfloat a) { _mm256_storeu_ps(p, a.v); }
+		inline vfloat splat(float f) { return { _mm256_set1_ps(f) }; }
+
+		inline vfloat operator+(vfloat a, vfloat b) { return { _mm256_add_ps(a.v, b.v) }; }
+		inline vfloat operator-(vfloat a, vfloat b) { return { _mm256_sub_ps(a.v, b.v) }; }
+		inline vfloat operator*(vfloat a, vfloat b) { return { _mm256_mul_ps(a.v, b.v) }; }
+		inline vfloat operator/(vfloat a, vfloat b) { return { _mm256_div_ps(a.v, b.v) }; }
+		inline vfloat operator-(vfloat a) { return { _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)) }; }
+
+		//returns a * b + c
+		inline vfloat madd(vfloat a, vfloat b, vfloat c) { return { _mm256_fmadd_ps(a.v, b.v, c.v) }; }
+
+		inline vfloat sqrt(vfloat a) { return { _mm256_sqrt_ps(a.v) }; }
+
+		//returns 1 / sqrt(a) to about 12 bits
+		inline vfloat rsqrt_estimate(vfloat a) { return { _mm256_rsqrt_ps(a.v) }; }
+
+		inline vfloat min(vfloat a, vfloat b) { return { _mm256_min_ps(a.v, b.v) }; }
+		inline vfloat max(vfloat a, vfloat b) { return { _mm256_max_ps(a.v, b.v) }; }
+		inline vfloat abs(vfloat a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+
+		//rounds to the nearest integer in the current rounding mode (ties to even by default)
+		inline vfloat round(vfloat a) { return { _mm256_round_ps(a.v, _MM_FROUND_CUR_DIRECTION) }; }
+
+		inline vmask operator==(vfloat a, vfloat b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ) }; }
+		inline vmask operator<(vfloat a, vfloat b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+		inline vmask operator>(vfloat a, vfloat b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+		inline vmask operator<=(vfloat a, vfloat b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+		inline vmask operator>=(vfloat a, vfloat b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+
+		inline vmask operator&(vmask a, vmask b) { return { _mm256_and_ps(a.v, b.v) }; }
+		inline vmask operator|(vmask a, vmask b) { return { _mm256_or_ps(a.v, b.v) }; }
+
+		//returns 'a' in the lanes where 'm' is set and 'b' in the others
+		inline vfloat select(vmask m, vfloat a, vfloat b) { return { _mm256_blendv_ps(b.v, a.v, m.v) }; }
+
+		//returns one bit per lane, set where 'm' is set
+		inline unsigned bits(vmask m) { return (unsigned)_mm256_movemask_ps(m.v); }
+
+		//splits 8 packed vec3s into x, y, and z lanes
+		inline void load3(const float* p, vfloat& x, vfloat& y, vfloat& z)
+		{
+			__m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+			__m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+			__m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+
+			x.v = _mm256_shuffle_ps(a, _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+			y.v = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			z.v = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+		}
+
+		//packs x, y, and z lanes into 8 vec3s
+		inline void store3(float* p, vfloat x, vfloat y, vfloat z)
+		{
+			__m256 a = _mm256_shuffle_ps(_mm256_shuffle_ps(x.v, y.v, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_shuffle_ps(z.v, x.v, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+			__m256 b = _mm256_shuffle_ps(_mm256_shuffle_ps(y.v, z.v, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_shuffle_ps(x.v, y.v, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+			__m256 c = _mm256_shuffle_ps(_mm256_shuffle_ps(z.v, x.v, _MM_SHUFFLE(3, 3, 2, 2)), _mm256_shuffle_ps(y.v, z.v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+			_mm_storeu_ps(p, _mm256_castps256_ps128(a));
+			_mm_storeu_ps(p + 4, _mm256_castps256_ps128(b));
+			_mm_storeu_ps(p + 8, _mm256_castps256_ps128(c));
+			_mm_storeu_ps(p + 12, _mm256_extractf128_ps(a, 1));
+			_mm_storeu_ps(p + 16, _mm256_extractf128_ps(b, 1));
+			_mm_storeu_ps(p + 20, _mm256_extractf128_ps(c, 1));
+		}
+
+		//splits 8 packed vec4s (or quats) into x, y, z, and w lanes
+		inline void load4(const float* p, vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			__m256 a0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 16), 1);
+			__m256 a1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 20), 1);
+			__m256 a2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 24), 1);
+			__m256 a3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 12)), _mm_loadu_ps(p + 28), 1);
+
+			__m256 t0 = _mm256_unpacklo_ps(a0, a1);
+			__m256 t1 = _mm256_unpacklo_ps(a2, a3);
+			__m256 t2 = _mm256_unpackhi_ps(a0, a1);
+			__m256 t3 = _mm256_unpackhi_ps(a2, a3);
+
+			x.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+			y.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+			z.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			w.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+
+		//packs x, y, z, and w lanes into 8 vec4s (or quats)
+		inline void store4(float* p, vfloat x, vfloat y, vfloat z, vfloat w)
+		{
+			__m256 t0 = _mm256_unpacklo_ps(x.v, y.v);
+			__m256 t1 = _mm256_unpacklo_ps(z.v, w.v);
+			__m256 t2 = _mm256_unpackhi_ps(x.v, y.v);
+			__m256 t3 = _mm256_unpackhi_ps(z.v, w.v);
+
+			__m256 r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+			__m256 r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+			_mm_storeu_ps(p, _mm256_castps256_ps128(r0));
+			_mm_storeu_ps(p + 4, _mm256_castps256_ps128(r1));
+			_mm_storeu_ps(p + 8, _mm256_castps256_ps128(r2));
+			_mm_storeu_ps(p + 12, _mm256_castps256_ps128(r3));
+			_mm_storeu_ps(p + 16, _mm256_extractf128_ps(r0, 1));
+			_mm_storeu_ps(p + 20, _mm256_extractf128_ps(r1, 1));
+			_mm_storeu_ps(p + 24, _mm256_extractf128_ps(r2, 1));
+			_mm_storeu_ps(p + 28, _mm256_extractf128_ps(r3, 1));
+		}
+
+		//splits the 8 vec4s at 'p', 'p' + 'stride', 'p' + 2 * 'stride', ... into x, y, z, and w lanes
+		inline void load4(const float* p, std::size_t stride, vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			__m256 a0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 4 * stride), 1);
+			__m256 a1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + stride)), _mm_loadu_ps(p + 5 * stride), 1);
+			__m256 a2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 2 * stride)), _mm_loadu_ps(p + 6 * stride), 1);
+			__m256 a3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 3 * stride)), _mm_loadu_ps(p + 7 * stride), 1);
+
+			__m256 t0 = _mm256_unpacklo_ps(a0, a1);
+			__m256 t1 = _mm256_unpacklo_ps(a2, a3);
+			__m256 t2 = _mm256_unpackhi_ps(a0, a1);
+			__m256 t3 = _mm256_unpackhi_ps(a2, a3);
+
+			x.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+			y.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+			z.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			w.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+
+		//splits the 8 vec4s at p[0] + 'offset', p[1] + 'offset', ... (one per lane) into x, y, z, and w lanes
+		inline void load4(const float* const* p, std::size_t offset, vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			__m256 a0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[0] + offset)), _mm_loadu_ps(p[4] + offset), 1);
+			__m256 a1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[1] + offset)), _mm_loadu_ps(p[5] + offset), 1);
+			__m256 a2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[2] + offset)), _mm_loadu_ps(p[6] + offset), 1);
+			__m256 a3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[3] + offset)), _mm_loadu_ps(p[7] + offset), 1);
+
+			__m256 t0 = _mm256_unpacklo_ps(a0, a1);
+			__m256 t1 = _mm256_unpacklo_ps(a2, a3);
+			__m256 t2 = _mm256_unpackhi_ps(a0, a1);
+			__m256 t3 = _mm256_unpackhi_ps(a2, a3);
+
+			x.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+			y.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+			z.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			w.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+
+		//packs x, y, z, and w lanes into 8 vec4s at 'p', 'p' + 'stride', 'p' + 2 * 'stride', ..., in that order
+		inline void store4(float* p, std::size_t stride, vfloat x, vfloat y, vfloat z, vfloat w)
+		{
+			__m256 t0 = _mm256_unpacklo_ps(x.v, y.v);
+			__m256 t1 = _mm256_unpacklo_ps(z.v, w.v);
+			__m256 t2 = _mm256_unpackhi_ps(x.v, y.v);
+			__m256 t3 = _mm256_unpackhi_ps(z.v, w.v);
+
+			__m256 r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+			__m256 r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+			_mm_storeu_ps(p, _mm256_castps256_ps128(r0));
+			_mm_storeu_ps(p + stride, _mm256_castps256_ps128(r1));
+			_mm_storeu_ps(p + 2 * stride, _mm256_castps256_ps128(r2));
+			_mm_storeu_ps(p + 3 * stride, _mm256_castps256_ps128(r3));
+			_mm_storeu_ps(p + 4 * stride, _mm256_extractf128_ps(r0, 1));
+			_mm_storeu_ps(p + 5 * stride, _mm256_extractf128_ps(r1, 1));
+			_mm_storeu_ps(p + 6 * stride, _mm256_extractf128_ps(r2, 1));
+			_mm_storeu_ps(p + 7 * stride, _mm256_extractf128_ps(r3, 1));
+		}
+
+		//splits the lanes of 'a' followed by 'b' into the even and odd elements
+		inline void deinterleave(vfloat a, vfloat b, vfloat& even, vfloat& odd)
+		{
+			__m256 e = _mm256_shuffle_ps(a.v, b.v, _MM_SHUFFLE(2, 0, 2, 0));
+			__m256 o = _mm256_shuffle_ps(a.v, b.v, _MM_SHUFFLE(3, 1, 3, 1));
+
+			//the shuffles work within 128 bit halves, leaving the 64 bit pairs in the order 0, 2, 1, 3
+			even.v = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(e), 0xD8));
+			odd.v = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(o), 0xD8));
+		}
+
+		//the reverse of deinterleave(): alternates the lanes of 'even' and 'odd' across 'a' and then 'b'
+		inline void interleave(vfloat even, vfloat odd, vfloat& a, vfloat& b)
+		{
+			__m256 lo = _mm256_unpacklo_ps(even.v, odd.v);
+			__m256 hi = _mm256_unpackhi_ps(even.v, odd.v);
+
+			a.v = _mm256_permute2f128_ps(lo, hi, 0x20);
+			b.v = _mm256_permute2f128_ps(lo, hi, 0x31);
+		}
+#elif defined(VECMATH_KERNEL_SSE2)
+		const unsigned width = 4;
+
+		struct vfloat { __m128 v; };
+		struct vmask { __m128 v; };
+
+		inline vfloat load(const float* p) { return { _mm_loadu_ps(p) }; }
+		inline void store(float* p, vfloat a) { _mm_storeu_ps(p, a.v); }
+		inline vfloat splat(float f) { return { _mm_set1_ps(f) }; }
+
+		inline vfloat operator+(vfloat a, vfloat b) { return { _mm_add_ps(a.v, b.v) }; }
+		inline vfloat operator-(vfloat a, vfloat b) { return { _mm_sub_ps(a.v, b.v) }; }
+		inline vfloat operator*(vfloat a, vfloat b) { return { _mm_mul_ps(a.v, b.v) }; }
+		inline vfloat operator/(vfloat a, vfloat b) { return { _mm_div_ps(a.v, b.v) }; }
+		inline vfloat operator-(vfloat a) { return { _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)) }; }
+
+		//returns a * b + c
+		inline vfloat madd(vfloat a, vfloat b, vfloat c) { return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) }; }
+
+		inline vfloat sqrt(vfloat a) { return { _mm_sqrt_ps(a.v) }; }
+
+		//returns 1 / sqrt(a) to about 12 bits
+		inline vfloat rsqrt_estimate(vfloat a) { return { _mm_rsqrt_ps(a.v) }; }
+
+		inline vfloat min(vfloat a, vfloat b) { return { _mm_min_ps(a.v, b.v) }; }
+		inline vfloat max(vfloat a, vfloat b) { return { _mm_max_ps(a.v, b.v) }; }
+		inline vfloat abs(vfloat a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+
+		//rounds to the nearest integer in the current rounding mode (ties to even by default)
+		//through a conversion to int32 (sse2 has no rounding instruction), so only for |a| < 2^31
+		inline vfloat round(vfloat a) { return { _mm_cvtepi32_ps(_mm_cvtps_epi32(a.v)) }; }
+
+		inline vmask operator==(vfloat a, vfloat b) { return { _mm_cmpeq_ps(a.v, b.v) }; }
+		inline vmask operator<(vfloat a, vfloat b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+		inline vmask operator>(vfloat a, vfloat b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+		inline vmask operator<=(vfloat a, vfloat b) { return { _mm_cmple_ps(a.v, b.v) }; }
+		inline vmask operator>=(vfloat a, vfloat b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+
+		inline vmask operator&(vmask a, vmask b) { return { _mm_and_ps(a.v, b.v) }; }
+		inline vmask operator|(vmask a, vmask b) { return { _mm_or_ps(a.v, b.v) }; }
+
+		//returns 'a' in the lanes where 'm' is set and 'b' in the others
+		inline vfloat select(vmask m, vfloat a, vfloat b) { return { _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)) }; }
+
+		//returns one bit per lane, set where 'm' is set
+		inline unsigned bits(vmask m) { return (unsigned)_mm_movemask_ps(m.v); }
+
+		//splits 4 packed vec3s (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) into x, y, and z lanes
+		inline void load3(const float* p, vfloat& x, vfloat& y, vfloat& z)
+		{
+			__m128 a = _mm_loadu_ps(p);
+			__m128 b = _mm_loadu_ps(p + 4);
+			__m128 c = _mm_loadu_ps(p + 8);
+
+			x.v = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+			y.v = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			z.v = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+		}
+
+		//packs x, y, and z lanes into 4 vec3s
+		inline void store3(float* p, vfloat x, vfloat y, vfloat z)
+		{
+			__m128 a = _mm_shuffle_ps(_mm_shuffle_ps(x.v, y.v, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z.v, x.v, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y.v, z.v, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x.v, y.v, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z.v, x.v, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y.v, z.v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+			_mm_storeu_ps(p, a);
+			_mm_storeu_ps(p + 4, b);
+			_mm_storeu_ps(p + 8, c);
+		}
+
+		//splits 4 packed vec4s (or quats) into x, y, z, and w lanes
+		inline void load4(const float* p, vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			__m128 t0 = _mm_unpacklo_ps(_mm_loadu_ps(p), _mm_loadu_ps(p + 4));
+			__m128 t1 = _mm_unpacklo_ps(_mm_loadu_ps(p + 8), _mm_loadu_ps(p + 12));
+			__m128 t2 = _mm_unpackhi_ps(_mm_loadu_ps(p), _mm_loadu_ps(p + 4));
+			__m128 t3 = _mm_unpackhi_ps(_mm_loadu_ps(p + 8), _mm_loadu_ps(p + 12));
+
+			x.v = _mm_movelh_ps(t0, t1);
+			y.v = _mm_movehl_ps(t1, t0);
+			z.v = _mm_movelh_ps(t2, t3);
+			w.v = _mm_movehl_ps(t3, t2);
+		}
+
+		//packs x, y, z, and w lanes into 4 vec4s (or quats)
+		inline void store4(float* p, vfloat x, vfloat y, vfloat z, vfloat w)
+		{
+			__m128 t0 = _mm_unpacklo_ps(x.v, y.v);
+			__m128 t1 = _mm_unpacklo_ps(z.v, w.v);
+			__m128 t2 = _mm_unpackhi_ps(x.v, y.v);
+			__m128 t3 = _mm_unpackhi_ps(z.v, w.v);
+
+			_mm_storeu_ps(p, _mm_movelh_ps(t0, t1));
+			_mm_storeu_ps(p + 4, _mm_movehl_ps(t1, t0));
+			_mm_storeu_ps(p + 8, _mm_movelh_ps(t2, t3));
+			_mm_storeu_ps(p + 12, _mm_movehl_ps(t3, t2));
+		}
+
+		//splits the 4 vec4s at 'p', 'p' + 'stride', 'p' + 2 * 'stride', and 'p' + 3 * 'stride' into x, y, z, and w lanes
+		inline void load4(const float* p, std::size_t stride, vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			__m128 a0 = _mm_loadu_ps(p), a1 = _mm_loadu_ps(p + stride);
+			__m128 a2 = _mm_loadu_ps(p + 2 * stride), a3 = _mm_loadu_ps(p + 3 * stride);
+
+			__m128 t0 = _mm_unpacklo_ps(a0, a1);
+			__m128 t1 = _mm_unpacklo_ps(a2, a3);
+			__m128 t2 = _mm_unpackhi_ps(a0, a1);
+			__m128 t3 = _mm_unpackhi_ps(a2, a3);
+
+			x.v = _mm_movelh_ps(t0, t1);
+			y.v = _mm_movehl_ps(t1, t0);
+			z.v = _mm_movelh_ps(t2, t3);
+			w.v = _mm_movehl_ps(t3, t2);
+		}
+
+		//splits the 4 vec4s at p[0] + 'offset', p[1] + 'offset', ... (one per lane) into x, y, z, and w lanes
+		inline void load4(const float* const* p, std::size_t offset, vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			__m128 a0 = _mm_loadu_ps(p[0] + offset), a1 = _mm_loadu_ps(p[1] + offset);
+			__m128 a2 = _mm_loadu_ps(p[2] + offset), a3 = _mm_loadu_ps(p[3] + offset);
+
+			__m128 t0 = _mm_unpacklo_ps(a0, a1);
+			__m128 t1 = _mm_unpacklo_ps(a2, a3);
+			__m128 t2 = _mm_unpackhi_ps(a0, a1);
+			__m128 t3 = _mm_unpackhi_ps(a2, a3);
+
+			x.v = _mm_movelh_ps(t0, t1);
+			y.v = _mm_movehl_ps(t1, t0);
+			z.v = _mm_movelh_ps(t2, t3);
+			w.v = _mm_movehl_ps(t3, t2);
+		}
+
+		//packs x, y, z, and w lanes into 4 vec4s at 'p', 'p' + 'stride', ..., in that order
+		inline void store4(float* p, std::size_t stride, vfloat x, vfloat y, vfloat z, vfloat w)
+		{
+			__m128 t0 = _mm_unpacklo_ps(x.v, y.v);
+			__m128 t1 = _mm_unpacklo_ps(z.v, w.v);
+			__m128 t2 = _mm_unpackhi_ps(x.v, y.v);
+			__m128 t3 = _mm_unpackhi_ps(z.v, w.v);
+
+			_mm_storeu_ps(p, _mm_movelh_ps(t0, t1));
+			_mm_storeu_ps(p + stride, _mm_movehl_ps(t1, t0));
+			_mm_storeu_ps(p + 2 * stride, _mm_movelh_ps(t2, t3));
+			_mm_storeu_ps(p + 3 * stride, _mm_movehl_ps(t3, t2));
+		}
+
+		//splits the lanes of 'a' followed by 'b' into the even and odd elements
+		inline void deinterleave(vfloat a, vfloat b, vfloat& even, vfloat& odd)
+		{
+			even.v = _mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(2, 0, 2, 0));
+			odd.v = _mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+
+		//the reverse of deinterleave(): alternates the lanes of 'even' and 'odd' across 'a' and then 'b'
+		inline void interleave(vfloat even, vfloat odd, vfloat& a, vfloat& b)
+		{
+			a.v = _mm_unpacklo_ps(even.v, odd.v);
+			b.v = _mm_unpackhi_ps(even.v, odd.v);
+		}
+#else
+		const unsigned width = 1;
+
+		struct vfloat { float v; };
+		struct vmask { bool v; };
+
+		inline vfloat load(const float* p) { return { *p }; }
+		inline void store(float* p, vfloat a) { *p = a.v; }
+		inline vfloat splat(float f) { return { f }; }
+
+		inline vfloat operator+(vfloat a, vfloat b) { return { a.v + b.v }; }
+		inline vfloat operator-(vfloat a, vfloat b) { return { a.v - b.v }; }
+		inline vfloat operator*(vfloat a, vfloat b) { return { a.v * b.v }; }
+		inline vfloat operator/(vfloat a, vfloat b) { return { a.v / b.v }; }
+		inline vfloat operator-(vfloat a) { return { -a.v }; }
+
+		//returns a * b + c
+		inline vfloat madd(vfloat a, vfloat b, vfloat c) { return { a.v * b.v + c.v }; }
+
+		inline vfloat sqrt(vfloat a) { return { std::sqrt(a.v) }; }
+
+		//exact here, so the newton step after it changes nothing
+		inline vfloat rsqrt_estimate(vfloat a) { return { 1.0f / std::sqrt(a.v) }; }
+
+		inline vfloat min(vfloat a, vfloat b) { return { a.v < b.v ? a.v : b.v }; }
+		inline vfloat max(vfloat a, vfloat b) { return { a.v > b.v ? a.v : b.v }; }
+		inline vfloat abs(vfloat a) { return { std::fabs(a.v) }; }
+		inline vfloat round(vfloat a) { return { std::nearbyint(a.v) }; }
+
+		inline vmask operator==(vfloat a, vfloat b) { return { a.v == b.v }; }
+		inline vmask operator<(vfloat a, vfloat b) { return { a.v < b.v }; }
+		inline vmask operator>(vfloat a, vfloat b) { return { a.v > b.v }; }
+		inline vmask operator<=(vfloat a, vfloat b) { return { a.v <= b.v }; }
+		inline vmask operator>=(vfloat a, vfloat b) { return { a.v >= b.v }; }
+
+		inline vmask operator&(vmask a, vmask b) { return { a.v && b.v }; }
+		inline vmask operator|(vmask a, vmask b) { return { a.v || b.v }; }
+
+		//returns 'a' in the lanes where 'm' is set and 'b' in the others
+		inline vfloat select(vmask m, vfloat a, vfloat b) { return m.v ? a : b; }
+
+		//returns one bit per lane, set where 'm' is set
+		inline unsigned bits(vmask m) { return m.v ? 1u : 0u; }
+
+		inline void load3(const float* p, vfloat& x, vfloat& y, vfloat& z)
+		{
+			x.v = p[0];
+			y.v = p[1];
+			z.v = p[2];
+		}
+
+		inline void store3(float* p, vfloat x, vfloat y, vfloat z)
+		{
+			p[0] = x.v;
+			p[1] = y.v;
+			p[2] = z.v;
+		}
+
+		inline void load4(const float* p, vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			x.v = p[0];
+			y.v = p[1];
+			z.v = p[2];
+			w.v = p[3];
+		}
+
+		inline void store4(float* p, vfloat x, vfloat y, vfloat z, vfloat w)
+		{
+			p[0] = x.v;
+			p[1] = y.v;
+			p[2] = z.v;
+			p[3] = w.v;
+		}
+
+		inline void load4(const float* p, std::size_t, vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			load4(p, x, y, z, w);
+		}
+
+		inline void load4(const float* const* p, std::size_t offset, vfloat& x, vfloat& y, vfloat& z, vfloat& w)
+		{
+			load4(p[0] + offset, x, y, z, w);
+		}
+
+		inline void store4(float* p, std::size_t, vfloat x, vfloat y, vfloat z, vfloat w)
+		{
+			store4(p, x, y, z, w);
+		}
+
+		inline void deinterleave(vfloat a, vfloat b, vfloat& even, vfloat& odd)
+		{
+			even = a;
+			odd = b;
+		}
+
+		inline void interleave(vfloat even, vfloat odd, vfloat& a, vfloat& b)
+		{
+			a = even;
+			b = odd;
+		}
+#endif
+
+		inline vfloat& operator+=(vfloat& a, vfloat b) { return (a = a + b); }
+		inline vfloat& operator-=(vfloat& a, vfloat b) { return (a = a - b); }
+		inline vfloat& operator*=(vfloat& a, vfloat b) { return (a = a * b); }
+	}
+	}
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef VECMATH_VMATH_H
+#define VECMATH_VMATH_H
+
+#include "vfloat.hpp"
+
+//private to the library: polynomial approximations of libm functions over vfloat lanes
+
+namespace vcm
+{
+	namespace simd
+	{
+	inline namespace VECMATH_KERNEL_ISA
+	{
+		//returns acos(x) for x in [0, 1]
+		//abramowitz & stegun 4.4.46, absolute error below 2e-8 (plus float rounding, ~2e-7 in total)
+		inline vfloat acos01(vfloat x)
+		{
+			vfloat p = splat(-0.0012624911f);
+			p = madd(p, x, splat(0.0066700901f));
+			p = madd(p, x, splat(-0.0170881256f));
+			p = madd(p, x, splat(0.0308918810f));
+			p = madd(p, x, splat(-0.0501743046f));
+			p = madd(p, x, splat(0.0889789874f));
+			p = madd(p, x, splat(-0.2145988016f));
+			p = madd(p, x, splat(1.5707963050f));
+
+			return sqrt(max(splat(1) - x, splat(0))) * p;
+		}
+
+		//returns sin(x) for x in [-pi/2, pi/2]
+		//taylor series to x^11, absolute error below 6e-8 (plus float rounding)
+		inline vfloat sin_half_pi(vfloat x)
+		{
+			vfloat x2 = x * x;
+
+			vfloat p = splat(-2.5052108e-8f);
+			p = madd(p, x2, splat(2.7557319e-6f));
+			p = madd(p, x2, splat(-1.9841270e-4f));
+			p = madd(p, x2, splat(8.3333333e-3f));
+			p = madd(p, x2, splat(-1.6666667e-1f));
+
+			return madd(p * x2, x, x);
+		}
+
+		//returns 1 / sqrt(x) for x > 0: the estimate refined by one newton step, like rsqrt_fast()
+		inline vfloat rsqrt(vfloat x)
+		{
+			vfloat r = rsqrt_estimate(x);
+			return splat(0.5f) * r * (splat(3) - x * r * r);
+		}
+
+		//writes sin(x) and cos(x) to 's' and 'c' for |x| <= 8192, like sincos_fast()
+		inline void sincos(vfloat x, vfloat& s, vfloat& c)
+		{
+			//x = k * pi / 2 + r with |r| <= pi / 4, with pi / 2 split in three parts (cody & waite)
+			vfloat k = round(x * splat(0.63661977236f));
+			vfloat r = madd(k, splat(-7.54978995489188216e-8f), madd(k, splat(-4.837512969970703125e-4f), madd(k, splat(-1.5703125f), x)));
+			vfloat z = r * r;
+
+			vfloat sp = madd(z, splat(-1.9515295891e-4f), splat(8.3321608736e-3f));
+			sp = madd(sp, z, splat(-1.6666654611e-1f));
+			vfloat sr = madd(r * z, sp, r);
+
+			vfloat cp = madd(z, splat(2.443315711809948e-5f), splat(-1.388731625493765e-3f));
+			cp = madd(cp, z, splat(4.166664568298827e-2f));
+			vfloat cr = madd(z * z, cp, madd(z, splat(-0.5f), splat(1)));
+
+			//the quadrant k mod 4, from a rounding that never ties for integers
+			vfloat q = k - round((k - splat(1.5f)) * splat(0.25f)) * splat(4);
+			vmask odd = (q == splat(1)) | (q == splat(3));
+
+			s = select(odd, cr, sr);
+			c = select(odd, sr, cr);
+
+			s = select(q >= splat(2), -s, s);
+			c = select((q == splat(1)) | (q == splat(2)), -c, c);
+		}
+	}
+	}
+}
+
+#endif